@@ -0,0 +1,157 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Benchmark.cpp
+--------------------------------------------------------------------------------
+Purpose: This driver compares balance thresholds. The same random inserts and
+         removes are run against a tree of ints at each threshold, then the
+         rotations done, the height of the tree, the average level of a node
+         and the time per find are printed so the trade off between fewer
+         rotations and deeper searches can be seen. The amount of finds that
+         hit is printed too, it must be the same on every line. The same run
+         then goes against the engine Engine.h picks for ints, the avl tree by
+         default or the fat node tree when built with -DFAT_NODE_ENGINE.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "Tree.h"
+#include "Engine.h"
+#include<iostream>
+#include<cstdlib>
+#include<chrono>
+#include<random>
+
+using namespace std;
+
+template<unsigned int Threshold> /* define template definition for function 
+                                    below */
+/*------------------------------------------------------------------------------
+Name:      run
+
+Purpose:   Insert operations random ints, remove a third of them again, then
+           find every int in range once. Print the results for this threshold.
+
+Parameters: operations: amount of ints inserted
+
+Return:     void
+------------------------------------------------------------------------------*/
+void run(unsigned int operations)
+{
+   Tree<int, Threshold> tree; /* tree at this threshold */
+   mt19937 random(2016); /* same sequence for every threshold */
+   unsigned int found = 0; /* finds that suceeded */
+
+   /* build the tree */
+   chrono :: steady_clock :: time_point start = chrono :: steady_clock :: now();
+
+   for(unsigned int i = 0; i < operations; ++i)
+      tree.insert(random() % (operations * 2));
+   for(unsigned int i = 0; i < operations / 3; ++i)
+      tree.remove(random() % (operations * 2));
+
+   chrono :: duration<double> build = chrono :: steady_clock :: now() - start;
+
+   /* search every key in range, about half of them miss */
+   start = chrono :: steady_clock :: now();
+
+   for(unsigned int i = 0; i < operations * 2; ++i)
+      found += tree.find(i);
+
+   chrono :: duration<double> search = chrono :: steady_clock :: now() - start;
+
+   cout << Threshold << "\t\t" << tree.rotation_count() << "\t\t"
+        << tree.tree_height() << "\t" << tree.average_level() << "\t\t"
+        << build.count() << "\t\t"
+        << search.count() * 1e9 / (operations * 2) << "\t\t"
+        << found << '\n';
+}
+
+/*------------------------------------------------------------------------------
+Name:      run_engine
+
+Purpose:   Same inserts, removes and finds as run, against the engine picked
+           for ints by the build. Its entries are then walked in order to check
+           they ascend and add up to its size.
+
+Parameters: operations: amount of ints inserted
+
+Return:     void
+------------------------------------------------------------------------------*/
+void run_engine(unsigned int operations)
+{
+   Engine<int> :: type tree; /* tree of the engine picked for ints */
+   mt19937 random(2016); /* same sequence as the thresholds */
+   unsigned int found = 0; /* finds that suceeded */
+   unsigned int walked = 0; /* entries seen walking in order */
+   bool ascending = true; /* every entry was above the one before */
+   int previous = 0; /* entry seen last */
+
+   /* build the tree */
+   chrono :: steady_clock :: time_point start = chrono :: steady_clock :: now();
+
+   for(unsigned int i = 0; i < operations; ++i)
+      tree.insert(random() % (operations * 2));
+   for(unsigned int i = 0; i < operations / 3; ++i)
+      tree.remove(random() % (operations * 2));
+
+   chrono :: duration<double> build = chrono :: steady_clock :: now() - start;
+
+   /* search every key in range, about half of them miss */
+   start = chrono :: steady_clock :: now();
+
+   for(unsigned int i = 0; i < operations * 2; ++i)
+      found += tree.find(i);
+
+   chrono :: duration<double> search = chrono :: steady_clock :: now() - start;
+
+   /* walk the entries in order */
+   for(auto node = tree.first_node(&tree); node; node = node->sucessor(node))
+   {
+      if(walked && !(previous < node->entry))
+         ascending = false;
+
+      previous = node->entry;
+      walked += node->count;
+   }
+
+   cout << "\nengine: " << Engine<int> :: name << " :: height: "
+        << tree.tree_height() << " :: build seconds: " << build.count()
+        << " :: ns per find: " << search.count() * 1e9 / (operations * 2)
+        << " :: found: " << found << " :: in order: "
+        << (ascending && walked == tree.size() ? "yes" : "no") << '\n';
+}
+
+/*------------------------------------------------------------------------------
+Name:      main
+
+Purpose:   Run the benchmark at thresholds 1, 2 and 3, then on the engine.
+
+Parameters: optional amount of ints to insert, 1000000 by default
+
+Return:     exit code
+------------------------------------------------------------------------------*/
+int main(int argc, char * argv[])
+{
+   unsigned int operations = 1000000; /* ints inserted per threshold */
+
+   /* amount given on the command line */
+   if(argc == 2)
+      operations = strtoul(argv[1], 0, 10);
+
+   /* invalid command line input */
+   if(argc > 2 || operations == 0)
+   {
+      cerr << "Usage: ./bench [amount of ints to insert]" << endl;
+      return 1; /* failure */
+   }
+
+   cout << "threshold\trotations\theight\taverage level\tbuild seconds"
+        << "\tns per find\tfound\n";
+
+   run<1>(operations);
+   run<2>(operations);
+   run<3>(operations);
+   run_engine(operations);
+
+   return 0; /* sucess */
+}
@@ -0,0 +1,152 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Bloom.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains the functions of the bloom filter. Blocks are sized
+         from the amount of entries expected and aligned to cache lines. Bits
+         24 and up of a hash pick the block, bits 0 to 23 give 6 bits to each
+         probe within it. The filter also counts the lookups it answered and
+         the ones it passed that turned out absent, giving a measured false
+         positive rate.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "Bloom.h"
+#include<cstring>
+#include<new>
+
+/*------------------------------------------------------------------------------
+Name:       BloomFilter
+
+Purpose:    Constructor for a bloom filter with about COUNTERS_PER_ENTRY
+            counters for every expected entry, rounded up to a power of 2 of
+            blocks. All counters start at 0.
+
+Parameters: expected: amount of entries expected in the filter
+
+Return:     none
+------------------------------------------------------------------------------*/
+BloomFilter :: BloomFilter(unsigned int expected)
+{
+   unsigned long long wanted = (unsigned long long)expected *
+                               COUNTERS_PER_ENTRY / BLOCK; /* blocks needed */
+
+   /* round up to a power of 2 so a mask picks the block */
+   blocks = 1;
+   while(blocks < wanted)
+      blocks <<= 1;
+
+   counters = static_cast<unsigned char *>(operator new[](blocks * BLOCK,
+                 std :: align_val_t(BLOCK)));
+   std :: memset(counters, 0, blocks * BLOCK);
+   negatives = false_positives = 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       ~BloomFilter
+
+Purpose:    Destructor freeing the counters.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+BloomFilter :: ~BloomFilter()
+{
+   operator delete[](counters, std :: align_val_t(BLOCK));
+}
+
+/*------------------------------------------------------------------------------
+Name:       add
+
+Purpose:    Count a hash into its block, counters already at 255 stay there.
+
+Parameters: hash: hash of the entry added
+
+Return:     void
+------------------------------------------------------------------------------*/
+void BloomFilter :: add(unsigned long long hash)
+{
+   unsigned char * block = counters + ((hash >> 24) & (blocks - 1)) * BLOCK;
+
+   for(unsigned int i = 0; i < PROBES; ++i, hash >>= 6)
+      if(block[hash & (BLOCK - 1)] < 255)
+         ++block[hash & (BLOCK - 1)];
+}
+
+/*------------------------------------------------------------------------------
+Name:       remove
+
+Purpose:    Count a hash out of its block. Counters at 255 may stand for more
+            entries than they show so they are left alone.
+
+Parameters: hash: hash of the entry removed, it must have been added
+
+Return:     void
+------------------------------------------------------------------------------*/
+void BloomFilter :: remove(unsigned long long hash)
+{
+   unsigned char * block = counters + ((hash >> 24) & (blocks - 1)) * BLOCK;
+
+   for(unsigned int i = 0; i < PROBES; ++i, hash >>= 6)
+      if(block[hash & (BLOCK - 1)] < 255)
+         --block[hash & (BLOCK - 1)];
+}
+
+/*------------------------------------------------------------------------------
+Name:       may_contain
+
+Purpose:    Whether a hash may have been added. Any zero counter means it surely
+            was not, which is counted as a negative.
+
+Parameters: hash: hash of the entry looked up
+
+Return:     false if the entry is surely absent
+------------------------------------------------------------------------------*/
+bool BloomFilter :: may_contain(unsigned long long hash)
+{
+   unsigned char * block = counters + ((hash >> 24) & (blocks - 1)) * BLOCK;
+
+   for(unsigned int i = 0; i < PROBES; ++i, hash >>= 6)
+      if(!block[hash & (BLOCK - 1)])
+      {
+         ++negatives;
+         return false;
+      }
+
+   return true;
+}
+
+/*------------------------------------------------------------------------------
+Name:       record_miss
+
+Purpose:    Note that a lookup the filter passed was not found, a false
+            positive.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void BloomFilter :: record_miss()
+{
+   ++false_positives;
+}
+
+/*------------------------------------------------------------------------------
+Name:       false_positive_rate
+
+Purpose:    Share of lookups of absent entries that the filter passed.
+
+Parameters: none
+
+Return:     measured false positive rate, 0 before any absent lookup
+------------------------------------------------------------------------------*/
+double BloomFilter :: false_positive_rate()
+{
+   /* no absent lookups yet */
+   if(negatives + false_positives == 0)
+      return 0;
+
+   return (double)false_positives / (negatives + false_positives);
+}
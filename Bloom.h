@@ -0,0 +1,63 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Bloom.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the bloom filter a tree can keep alongside
+         its nodes. It answers whether an entry may be in the tree, so a find of
+         an entry that is surely absent skips walking down the tree. Each entry
+         touches a single cache line of counters, and counters let entries be
+         taken out again when nodes are removed.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef BLOOM_H
+#define BLOOM_H
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        BloomFilter
+
+Purpose:     Blocked counting bloom filter over 64 bit hashes. The high bits of
+             a hash pick a block of 64 one byte counters, one cache line, and
+             the low bits pick PROBES counters within it. Counters stop at 255
+             and are never decremented from there so no entry is ever lost.
+
+Data Fields: counters:        all blocks of counters
+             blocks:          amount of blocks, a power of 2
+             negatives:       lookups the filter answered as absent
+             false_positives: lookups the filter passed that were absent
+
+Functions: BloomFilter:         constructor
+           ~BloomFilter:        destructor
+           add:                 count a hash in
+           remove:              count a hash out
+           may_contain:         whether a hash may have been added
+           record_miss:         note a passed lookup that was absent
+           false_positive_rate: measured rate of passed absent lookups
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class BloomFilter
+{
+   private:
+      /* data fields */
+      unsigned char * counters;       /* all blocks of counters */
+      unsigned long long blocks;      /* amount of blocks, a power of 2 */
+      unsigned long long negatives,   /* lookups answered as absent */
+                         false_positives; /* passed lookups that were absent 
+                                             */
+
+   public:
+      static const unsigned int BLOCK = 64; /* counters in a block */
+      static const unsigned int PROBES = 4; /* counters per hash */
+      static const unsigned int COUNTERS_PER_ENTRY = 10; /* sizing of blocks */
+
+      /* functions */
+      BloomFilter(unsigned int); /* constructor for an expected entry count */
+      ~BloomFilter(void); /* destructor freeing the counters */
+      void add(unsigned long long); /* count a hash in */
+      void remove(unsigned long long); /* count a hash out */
+      bool may_contain(unsigned long long); /* whether a hash may be in */
+      void record_miss(void); /* note a passed lookup that was absent */
+      double false_positive_rate(void); /* measured rate of false positives */
+};
+
+#endif
@@ -1,42 +1,585 @@
 /*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
                                                       Author: Jeremy Cruz
-                                                      
+
                                                       Date:   2016
 
                                    Driver.cpp
 --------------------------------------------------------------------------------
-Purpose: This driver will test our tree by taking a file of data as a 
-         command line input. This will test a tree of strings.
+Purpose: This driver will test our tree by taking a file of data as a
+         command line input. This will test a tree of strings. In replay mode
+         the file is instead a script of operations that are run against the
+         tree one by one, timing each, to report throughput and latency
+         percentiles for every kind of operation. With --filter the tree keeps
+         a bloom filter and its false positive rate is reported as well, with
+         --cache it keeps a lookup cache and its hits and misses are reported.
+         In shared mode the entries of the file go into a shared tree that a
+         writer process changes while reader processes check it.
 =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
 #include "Tree.h"
+#include "Histogram.h"
+#include "StaticTree.h"
+#include "SharedTree.h"
 #include<iostream>
 #include<string>
+#include<string_view>
 #include<fstream>
+#include<vector>
+#include<chrono>
+#include<algorithm>
+#include<csignal>
+#include<unistd.h>
+#include<sys/wait.h>
 
 using namespace std;
 
+static const unsigned int REPLAY_CACHE_SLOTS = 1024; /* lookup cache slots
+                                                        with --cache */
+static const unsigned int SHARED_READERS = 4; /* reader processes forked with
+                                                 --shared */
+static const unsigned int SHARED_PASSES = 200; /* times each reader checks the
+                                                  tree */
+static const unsigned int SHARED_ATTEMPTS = 1000; /* times the writer is
+                                                     stopped to catch it in a
+                                                     change */
+static const unsigned int SHARED_RUN = 100; /* microseconds the writer runs
+                                               between stops */
+
+/* kinds of operations in a replay script */
+enum OperationType
+{
+   INSERT, /* insert <entry> */
+   FIND,   /* find <entry> */
+   REMOVE, /* remove <entry> */
+   RANGE,  /* range <low><tab><high> */
+   OPERATION_TYPES /* amount of kinds */
+};
+
+/* names of the kinds as written in a script */
+static const char * const OPERATION_NAMES[OPERATION_TYPES] =
+   { "insert", "find", "remove", "range" };
+
+/* the same names built into a static tree while compiling, to reject unknown
+   names before looking up their kind */
+static constexpr StaticTree<string_view, OPERATION_TYPES> OPERATION_TREE =
+   make_static_tree<string_view>({ "insert", "find", "remove", "range" });
+static_assert(OPERATION_TREE.find("range"), "range is an operation");
+static_assert(!OPERATION_TREE.find("rank"), "rank is not an operation");
+static_assert(OPERATION_TREE.first_node(&OPERATION_TREE)->entry == "find",
+              "find is the smallest name");
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        Operation
+
+Purpose:     One line of a replay script.
+
+Data Fields: type:  kind of operation
+             entry: entry operated on, low end of a range
+             high:  high end of a range
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct Operation
+{
+   OperationType type; /* kind of operation */
+   string entry;       /* entry operated on */
+   string high;        /* high end of a range */
+};
+
+/*------------------------------------------------------------------------------
+Name:      parse
+
+Purpose:   Read a replay script into operations. Each line is an operation name
+           followed by a space and the entry, which runs to the end of the line.
+           A range gives its low and high entries separated by a tab. Empty
+           lines and lines starting with # are skipped.
+
+Parameters: fio:        open script file
+            operations: filled with the operations of the script
+
+Return:     line number of the first invalid line, 0 if all are valid
+------------------------------------------------------------------------------*/
+static unsigned int parse(ifstream & fio, vector<Operation> & operations)
+{
+   string line; /* line being parsed */
+   unsigned int number = 0; /* line number */
+
+   while(getline(fio, line))
+   {
+      ++number;
+
+      /* skip empty lines and comments */
+      if(line.empty() || line[0] == '#')
+         continue;
+
+      string :: size_type space = line.find(' '); /* end of the name */
+      string name = line.substr(0, space); /* operation name */
+      Operation operation; /* operation of this line */
+      int type = 0; /* kind matching the name */
+
+      /* unknown operation or no entry */
+      if(!OPERATION_TREE.find(name) || space == string :: npos)
+         return number;
+
+      /* look up the kind by name */
+      while(name != OPERATION_NAMES[type])
+         ++type;
+
+      operation.type = (OperationType)type;
+      operation.entry = line.substr(space + 1);
+
+      /* split a range at the tab */
+      if(operation.type == RANGE)
+      {
+         string :: size_type tab = operation.entry.find('\t');
+
+         if(tab == string :: npos)
+            return number;
+
+         operation.high = operation.entry.substr(tab + 1);
+         operation.entry.erase(tab);
+      }
+
+      operations.push_back(operation);
+   }
+
+   return 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:      replay
+
+Purpose:   Run every operation of a replay script against a tree of strings,
+           timing each one. Parsing is done before the clock starts. Prints the
+           throughput of the whole run, then count, mean and p50, p99 and p999
+           latency in nanoseconds for each kind of operation. A bloom filter
+           is sized for every insert of the script so it never fills up.
+
+Parameters: filename: name of the script file
+            filter:   keep a bloom filter and report its false positive rate
+            cache:    keep a lookup cache and report its hits and misses
+
+Return:     exit code
+------------------------------------------------------------------------------*/
+static int replay(const char * filename, bool filter, bool cache)
+{
+   ifstream fio(filename, ios :: binary); /* script file */
+   vector<Operation> operations; /* operations of the script */
+   Histogram latencies[OPERATION_TYPES]; /* latencies of each kind */
+   Tree<string> tree; /* tree of strings */
+   unsigned long long results = 0; /* sucesses and entries in ranges, keeps
+                                      the work from being skipped */
+
+   /* file not found */
+   if(!fio.is_open())
+   {
+      cerr << "File not found!" << endl;
+      return 1; /* failure */
+   }
+
+   /* invalid script */
+   unsigned int invalid = parse(fio, operations);
+   if(invalid)
+   {
+      cerr << "Invalid operation on line " << invalid << "!" << endl;
+      return 1; /* failure */
+   }
+
+   fio.close();
+
+   /* size the filter for the most entries the script can hold */
+   if(filter)
+   {
+      unsigned int inserts = 0; /* insert operations in the script */
+
+      for(vector<Operation> :: size_type i = 0; i < operations.size(); ++i)
+         inserts += operations[i].type == INSERT;
+
+      tree.enable_filter(inserts);
+   }
+
+   if(cache)
+      tree.enable_cache(REPLAY_CACHE_SLOTS);
+
+   chrono :: steady_clock :: time_point start = chrono :: steady_clock :: now();
+
+   /* run and time every operation */
+   for(vector<Operation> :: size_type i = 0; i < operations.size(); ++i)
+   {
+      const Operation & operation = operations[i];
+      chrono :: steady_clock :: time_point before =
+         chrono :: steady_clock :: now();
+
+      switch(operation.type)
+      {
+         case INSERT: results += tree.insert(operation.entry); break;
+         case FIND: results += tree.find(operation.entry); break;
+         case REMOVE: results += tree.remove(operation.entry); break;
+         case RANGE: results += tree.range(operation.entry, operation.high);
+                     break;
+         default: break;
+      }
+
+      latencies[operation.type].record(
+         chrono :: duration_cast<chrono :: nanoseconds>(
+            chrono :: steady_clock :: now() - before).count());
+   }
+
+   chrono :: duration<double> seconds = chrono :: steady_clock :: now() - start;
+
+   /* whole run */
+   cout << "operations: " << operations.size() << " :: seconds: "
+        << seconds.count() << " :: throughput: "
+        << operations.size() / seconds.count() << " ops/s :: results: "
+        << results << '\n';
+
+   /* absent finds the filter let through */
+   if(filter)
+      cout << "filter :: false positive rate: "
+           << tree.filter_false_positive_rate() << '\n';
+
+   /* finds the cache answered */
+   if(cache)
+      cout << "cache :: hits: " << tree.cache_hits() << " :: misses: "
+           << tree.cache_misses() << '\n';
+
+   /* each kind of operation that was run */
+   for(int type = 0; type < OPERATION_TYPES; ++type)
+   {
+      Histogram & histogram = latencies[type];
+
+      if(histogram.count() == 0)
+         continue;
+
+      cout << OPERATION_NAMES[type] << " :: count: " << histogram.count()
+           << " :: mean: " << histogram.sum() / histogram.count() << " ns"
+           << " :: p50: " << histogram.percentile(0.5) << " ns"
+           << " :: p99: " << histogram.percentile(0.99) << " ns"
+           << " :: p999: " << histogram.percentile(0.999) << " ns\n";
+   }
+
+   return 0; /* sucess */
+}
+
+/*------------------------------------------------------------------------------
+Name:      shared_writer
+
+Purpose:   Writer process of the shared mode. Creates the segment, inserts every
+           entry, tells the parent it is ready, then removes and inserts the
+           churn entries again and again until it is killed.
+
+Parameters: name:   name of the segment
+            all:    every entry, in ascending order
+            churn:  entries taken out and put back
+            ready:  write end of the pipe to the parent
+
+Return:     exit code, only if a change did not give the expected result
+------------------------------------------------------------------------------*/
+static int shared_writer(const char * name, const vector<string> & all,
+                         const vector<string> & churn, int ready)
+{
+   SharedTree tree; /* writer handle */
+   char byte = 1; /* sent once the tree is built */
+
+   if(!tree.create(name, all.size()))
+      return 1; /* failure */
+
+   for(vector<string> :: size_type i = 0; i < all.size(); ++i)
+      if(tree.insert(all[i]) != SHARED_INSERTED)
+         return 1; /* failure */
+
+   if(write(ready, &byte, 1) != 1)
+      return 1; /* failure */
+
+   /* churn until killed by the parent */
+   while(true)
+   {
+      for(vector<string> :: size_type i = 0; i < churn.size(); ++i)
+         if(!tree.remove(churn[i]))
+            return 1; /* failure */
+
+      for(vector<string> :: size_type i = 0; i < churn.size(); ++i)
+         if(tree.insert(churn[i]) != SHARED_INSERTED)
+            return 1; /* failure */
+   }
+}
+
+/*------------------------------------------------------------------------------
+Name:      shared_matches
+
+Purpose:   Compare what a reader sees against what the writer can have in the
+           tree: every stable entry, any of the churn entries, in ascending
+           order.
+
+Parameters: tree:   reader handle
+            all:    every entry, in ascending order
+            stable: entries never taken out, in ascending order
+
+Return:     whether the reader saw a valid tree
+------------------------------------------------------------------------------*/
+static bool shared_matches(SharedTree & tree, const vector<string> & all,
+                           const vector<string> & stable)
+{
+   vector<string> seen; /* entries the reader copied out */
+
+   for(vector<string> :: size_type i = 0; i < stable.size(); ++i)
+      if(!tree.find(stable[i]))
+         return false;
+
+   if(!tree.entries(seen))
+      return false;
+
+   return is_sorted(seen.begin(), seen.end()) &&
+          adjacent_find(seen.begin(), seen.end()) == seen.end() &&
+          includes(all.begin(), all.end(), seen.begin(), seen.end()) &&
+          includes(seen.begin(), seen.end(), stable.begin(), stable.end());
+}
+
+/*------------------------------------------------------------------------------
+Name:      shared_reader
+
+Purpose:   Reader process of the shared mode. Opens the segment, checks that it
+           may not insert, then checks every read against the entries the
+           writer can have in the tree while the writer keeps changing it.
+
+Parameters: name:   name of the segment
+            all:    every entry, in ascending order
+            stable: entries never taken out, in ascending order
+
+Return:     exit code
+------------------------------------------------------------------------------*/
+static int shared_reader(const char * name, const vector<string> & all,
+                         const vector<string> & stable)
+{
+   SharedTree tree; /* reader handle */
+
+   if(!tree.open(name) || tree.insert(all[0]) != SHARED_READ_ONLY)
+      return 1; /* failure */
+
+   for(unsigned int pass = 0; pass < SHARED_PASSES; ++pass)
+      if(!shared_matches(tree, all, stable))
+         return 1; /* failure */
+
+   return 0; /* sucess */
+}
+
+/*------------------------------------------------------------------------------
+Name:      shared
+
+Purpose:   Test the shared tree across processes with the entries of a data
+           file. A forked writer builds the tree and keeps removing and
+           inserting half of it while forked readers check every read against
+           the other half. The writer is then stopped again and again until
+           caught in the middle of a change, where a read must give up once
+           SHARED_READ_WAIT is over, and killed there, where a read must give
+           up at once. Whether
+           it was caught is reported, a file of one entry leaves nothing to
+           change. Entries over SHARED_KEY_MAX bytes are left out.
+
+Parameters: filename: name of the data file
+
+Return:     exit code
+------------------------------------------------------------------------------*/
+static int shared(const char * filename)
+{
+   ifstream fio(filename, ios :: binary); /* data file */
+   vector<string> all, stable, churn; /* every entry, split in two halves */
+   string data; /* line of the file */
+   string name = "/avl_tree_" + to_string(getpid()); /* segment name */
+   unsigned int too_long = 0; /* entries left out */
+   unsigned int failed = 0; /* readers that saw a wrong tree */
+   pid_t readers[SHARED_READERS]; /* processes checking the tree */
+   int ready[2]; /* pipe the writer tells it is ready through */
+   char byte; /* read from the pipe */
+   int status; /* exit status of a child */
+
+   /* file not found */
+   if(!fio.is_open())
+   {
+      cerr << "File not found!" << endl;
+      return 1; /* failure */
+   }
+
+   while(getline(fio, data))
+   {
+      if(data.size() > SHARED_KEY_MAX)
+         ++too_long;
+      else
+         all.push_back(data);
+   }
+
+   fio.close();
+
+   /* file is empty */
+   if(all.empty())
+   {
+      cerr << "File is empty!" << endl;
+      return 1; /* failure */
+   }
+
+   /* distinct entries in ascending order, every other one churns */
+   sort(all.begin(), all.end());
+   all.erase(unique(all.begin(), all.end()), all.end());
+
+   for(vector<string> :: size_type i = 0; i < all.size(); ++i)
+   {
+      if(i % 2)
+         churn.push_back(all[i]);
+      else
+         stable.push_back(all[i]);
+   }
+
+   if(pipe(ready) != 0)
+   {
+      cerr << "Could not make a pipe!" << endl;
+      return 1; /* failure */
+   }
+
+   cout.flush(); /* children must not print what is buffered */
+
+   pid_t writer = fork(); /* process changing the tree */
+   if(writer == 0)
+   {
+      ::close(ready[0]);
+      _exit(shared_writer(name.c_str(), all, churn, ready[1]));
+   }
+
+   ::close(ready[1]);
+
+   /* writer failed before the tree was built */
+   if(writer < 0 || read(ready[0], &byte, 1) != 1)
+   {
+      ::close(ready[0]);
+      SharedTree :: destroy(name.c_str());
+      cerr << "Writer could not build the shared tree!" << endl;
+      return 1; /* failure */
+   }
+
+   ::close(ready[0]);
+
+   /* readers check the tree while the writer changes it */
+   for(unsigned int i = 0; i < SHARED_READERS; ++i)
+      if((readers[i] = fork()) == 0)
+         _exit(shared_reader(name.c_str(), all, stable));
+
+   for(unsigned int i = 0; i < SHARED_READERS; ++i)
+      if(readers[i] < 0 || waitpid(readers[i], &status, 0) < 0 ||
+         !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+         ++failed;
+
+   SharedTree tree; /* reader handle of this process */
+   unsigned int attempts = 0; /* times the writer was stopped */
+   bool caught = false; /* writer stopped in the middle of a change */
+   bool wrong = !tree.open(name.c_str()); /* a read here saw a wrong tree */
+   bool running = true; /* writer has not exited by itself */
+   chrono :: duration<double> waited(0), dead(0); /* time reads gave up in */
+
+   /* stop the writer until it is caught in a change, check the tree when not
+      caught */
+   while(!wrong && !caught && attempts < SHARED_ATTEMPTS &&
+         (running = waitpid(writer, &status, WNOHANG) == 0))
+   {
+      ++attempts;
+      kill(writer, SIGSTOP);
+      waitpid(writer, &status, WUNTRACED);
+
+      chrono :: steady_clock :: time_point start =
+         chrono :: steady_clock :: now();
+
+      if(!tree.find(all[0]) && tree.stalled())
+      {
+         waited = chrono :: steady_clock :: now() - start;
+         caught = true;
+      }
+      else
+      {
+         wrong = !shared_matches(tree, all, stable);
+         kill(writer, SIGCONT);
+         usleep(SHARED_RUN); /* let the writer get going again */
+      }
+   }
+
+   /* kill the writer, still in the middle of a change when caught */
+   if(running)
+   {
+      kill(writer, SIGKILL);
+      waitpid(writer, &status, 0);
+   }
+
+   if(caught)
+   {
+      chrono :: steady_clock :: time_point start =
+         chrono :: steady_clock :: now();
+
+      wrong = wrong || tree.find(all[0]) || !tree.stalled();
+      dead = chrono :: steady_clock :: now() - start;
+   }
+
+   tree.close();
+   SharedTree :: destroy(name.c_str());
+
+   cout << "shared :: entries: " << all.size() << " :: too long: " << too_long
+        << " :: readers: " << SHARED_READERS << " :: failed readers: "
+        << failed << '\n'
+        << "stalled :: caught in a change: " << (caught ? "yes" : "no")
+        << " :: attempts: " << attempts << " :: stopped writer ms: "
+        << waited.count() * 1e3 << " :: dead writer ms: "
+        << dead.count() * 1e3 << '\n';
+
+   return failed || wrong || !running; /* failure if any check failed */
+}
+
 /*------------------------------------------------------------------------------
 Name:      main
 
-Purpose:   Test the tree by inserting strings from an input file from the 
-           command line.
+Purpose:   Test the tree by inserting strings from an input file from the
+           command line, replay a script of operations with --replay, or test
+           the shared tree with the strings of a file with --shared.
 
-Parameters: name of input file
+Parameters: name of input file, or --replay, optional --filter and --cache
+            and name of script file, or --shared and name of input file
 
 Return:     exit code
 ------------------------------------------------------------------------------*/
 int main(int argc, char * argv[])
 {
-   ifstream fio; /* input file object */
-   fio.open(argv[1], ios :: binary); /* open file in binary mode */
+   /* shared tree mode */
+   if(argc == 3 && string(argv[1]) == "--shared")
+      return shared(argv[2]);
+
+   /* replay mode, flags come before the script */
+   if(argc >= 3 && string(argv[1]) == "--replay")
+   {
+      bool filter = false; /* keep a bloom filter */
+      bool cache = false; /* keep a lookup cache */
+      int flag = 2; /* argument being read */
+
+      for(; flag < argc - 1; ++flag)
+      {
+         if(string(argv[flag]) == "--filter")
+            filter = true;
+         else if(string(argv[flag]) == "--cache")
+            cache = true;
+         else
+            break;
+      }
+
+      /* every argument before the script was a flag */
+      if(flag == argc - 1)
+         return replay(argv[flag], filter, cache);
+   }
 
    /* invalid command line input */
-   if(argc != 2)
+   if(argc != 2 || string(argv[1]) == "--replay" ||
+      string(argv[1]) == "--shared")
    {
-      cerr << "Usage: ./main <filename of data file>" << endl;
+      cerr << "Usage: ./main <filename of data file>" << endl
+           << "       ./main --replay [--filter] [--cache] "
+           << "<filename of operation script>" << endl
+           << "       ./main --shared <filename of data file>" << endl;
       return 1; /* failure */
    }
 
+   ifstream fio; /* input file object */
+   fio.open(argv[1], ios :: binary); /* open file in binary mode */
+
    /* file not found */
    if(!fio.is_open())
    {
@@ -64,7 +607,7 @@ int main(int argc, char * argv[])
    /* insert all file contents into tree */
    while(getline(fio, data))
       tree.insert(data);
-   
+
    /*close the file and print the tree contents */
    fio.close();
    tree.print_tree();
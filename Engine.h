@@ -0,0 +1,53 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Engine.h
+--------------------------------------------------------------------------------
+Purpose: Compile time choice of the engine behind a tree of a given type. By
+         default every type uses the avl tree. Building with -DFAT_NODE_ENGINE
+         switches int, long, float and double over to the fat node tree, which
+         has the same insert, remove, find, range, count, size, export_tree
+         and print_tree functions and is walked with the same first_node and
+         sucessor loop. Use Engine<Data> :: type wherever the engine should
+         follow the build, Engine<Data> :: name tells which one it is.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef ENGINE_H
+#define ENGINE_H
+#include "Tree.h"
+#include "FatTree.h"
+
+/* avl tree for every type unless specialized below */
+template<typename Data>
+struct Engine
+{
+   typedef Tree<Data> type;
+   static constexpr const char * name = "avl";
+};
+
+#ifdef FAT_NODE_ENGINE
+/* fat node tree for the arithmetic types */
+template<> struct Engine<int>
+{
+   typedef FatTree<int> type;
+   static constexpr const char * name = "fat node";
+};
+template<> struct Engine<long>
+{
+   typedef FatTree<long> type;
+   static constexpr const char * name = "fat node";
+};
+template<> struct Engine<float>
+{
+   typedef FatTree<float> type;
+   static constexpr const char * name = "fat node";
+};
+template<> struct Engine<double>
+{
+   typedef FatTree<double> type;
+   static constexpr const char * name = "fat node";
+};
+#endif
+
+#endif
@@ -0,0 +1,413 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Export.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains the functions of the export buffer. Numbers are
+         formatted with to_chars straight into the buffer. Plain entries use 6
+         significant digits for floating point like a default stream so the
+         node listing matches what print_tree always printed, keys, JSON and
+         DOT use the shortest text that reads back as the same value so
+         distinct entries never print alike. Once the buffer holds CAPACITY
+         bytes it is written to the stream in one block, the stream itself is
+         never flushed.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "Export.h"
+#include<charconv>
+#include<cmath>
+
+template<typename Number> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       append_number
+
+Purpose:    Format an integer at the end of the text.
+
+Parameters: text:   text to append to
+            number: integer to format
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void append_number(std :: string & text, Number number)
+{
+   char digits[32]; /* large enough for any 64 bit integer */
+   std :: to_chars_result result = std :: to_chars(digits, digits + 32, number);
+
+   text.append(digits, result.ptr);
+}
+
+template<typename Number> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       append_real
+
+Purpose:    Format a floating point number at the end of the text with 6
+            significant digits, the same as a default stream.
+
+Parameters: text:   text to append to
+            number: floating point number to format
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void append_real(std :: string & text, Number number)
+{
+   char digits[64]; /* large enough for any float or double at 6 digits */
+   std :: to_chars_result result = std :: to_chars(digits, digits + 64, number,
+                                      std :: chars_format :: general, 6);
+
+   text.append(digits, result.ptr);
+}
+
+template<typename Number> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       append_exact
+
+Purpose:    Format a floating point number at the end of the text with the
+            fewest digits that still read back as exactly the same number.
+
+Parameters: text:   text to append to
+            number: floating point number to format
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void append_exact(std :: string & text, Number number)
+{
+   char digits[64]; /* large enough for any float or double */
+   std :: to_chars_result result = std :: to_chars(digits, digits + 64, number);
+
+   text.append(digits, result.ptr);
+}
+
+/*------------------------------------------------------------------------------
+Name:       ExportBuffer
+
+Purpose:    Constructor for an export buffer, reserves the whole buffer up
+            front.
+
+Parameters: out: stream the text ends up in
+
+Return:     none
+------------------------------------------------------------------------------*/
+ExportBuffer :: ExportBuffer(std :: ostream & out) : out(out)
+{
+   buffer.reserve(CAPACITY + 256); /* room for one more line past capacity */
+}
+
+/*------------------------------------------------------------------------------
+Name:       ~ExportBuffer
+
+Purpose:    Destructor, writes whatever is left in the buffer.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+ExportBuffer :: ~ExportBuffer()
+{
+   flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       put
+
+Purpose:    Append text, writing the buffer once it is full.
+
+Parameters: text: null terminated text to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put(const char * text)
+{
+   buffer.append(text);
+
+   if(buffer.size() >= CAPACITY)
+      flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       put
+
+Purpose:    Append a single character, writing the buffer once it is full.
+
+Parameters: letter: character to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put(char letter)
+{
+   buffer.push_back(letter);
+
+   if(buffer.size() >= CAPACITY)
+      flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       put
+
+Purpose:    Append an unsigned number such as a node attribute.
+
+Parameters: number: number to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put(unsigned int number)
+{
+   append_number(buffer, number);
+}
+
+/*------------------------------------------------------------------------------
+Name:       put
+
+Purpose:    Append a signed number such as a balance.
+
+Parameters: number: number to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put(int number)
+{
+   append_number(buffer, number);
+}
+
+/*------------------------------------------------------------------------------
+Name:       put_entry
+
+Purpose:    Append an entry as plain text, the same text a stream would print.
+            Strings may be long so they go through put to check capacity.
+
+Parameters: entry: entry to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_entry(char entry) { put(entry); }
+void ExportBuffer :: put_entry(short entry) { append_number(buffer, entry); }
+void ExportBuffer :: put_entry(int entry) { append_number(buffer, entry); }
+void ExportBuffer :: put_entry(long entry) { append_number(buffer, entry); }
+void ExportBuffer :: put_entry(float entry) { append_real(buffer, entry); }
+void ExportBuffer :: put_entry(double entry) { append_real(buffer, entry); }
+void ExportBuffer :: put_entry(const std :: string & entry)
+{
+   buffer.append(entry);
+
+   if(buffer.size() >= CAPACITY)
+      flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       put_key
+
+Purpose:    Append an entry as plain text that reads back as the same entry.
+            Only floating point differs from put_entry, using as many digits
+            as it takes.
+
+Parameters: entry: entry to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_key(char entry) { put_entry(entry); }
+void ExportBuffer :: put_key(short entry) { put_entry(entry); }
+void ExportBuffer :: put_key(int entry) { put_entry(entry); }
+void ExportBuffer :: put_key(long entry) { put_entry(entry); }
+void ExportBuffer :: put_key(float entry) { append_exact(buffer, entry); }
+void ExportBuffer :: put_key(double entry) { append_exact(buffer, entry); }
+void ExportBuffer :: put_key(const std :: string & entry) { put_entry(entry); }
+
+/*------------------------------------------------------------------------------
+Name:       put_json
+
+Purpose:    Append an entry as a JSON value. Numbers are written bare and in
+            full, with null for infinity and NaN which JSON cannot hold.
+            Characters and strings are written as escaped JSON strings.
+
+Parameters: entry: entry to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_json(char entry)
+{
+   put('"');
+   put_escaped(&entry, 1);
+   put('"');
+}
+void ExportBuffer :: put_json(short entry) { put_entry(entry); }
+void ExportBuffer :: put_json(int entry) { put_entry(entry); }
+void ExportBuffer :: put_json(long entry) { put_entry(entry); }
+void ExportBuffer :: put_json(float entry)
+{
+   if(std :: isfinite(entry))
+      put_key(entry);
+   else
+      put("null");
+}
+void ExportBuffer :: put_json(double entry)
+{
+   if(std :: isfinite(entry))
+      put_key(entry);
+   else
+      put("null");
+}
+void ExportBuffer :: put_json(const std :: string & entry)
+{
+   put('"');
+   put_escaped(entry.data(), entry.size());
+   put('"');
+}
+
+/*------------------------------------------------------------------------------
+Name:       put_dot
+
+Purpose:    Append an entry as a quoted DOT string, used as a node label.
+            Numbers are written in full, characters and strings escaped for
+            DOT.
+
+Parameters: entry: entry to append
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_dot(char entry)
+{
+   put('"');
+   put_dot_escaped(&entry, 1);
+   put('"');
+}
+void ExportBuffer :: put_dot(short entry)
+{
+   put('"');
+   put_key(entry);
+   put('"');
+}
+void ExportBuffer :: put_dot(int entry)
+{
+   put('"');
+   put_key(entry);
+   put('"');
+}
+void ExportBuffer :: put_dot(long entry)
+{
+   put('"');
+   put_key(entry);
+   put('"');
+}
+void ExportBuffer :: put_dot(float entry)
+{
+   put('"');
+   put_key(entry);
+   put('"');
+}
+void ExportBuffer :: put_dot(double entry)
+{
+   put('"');
+   put_key(entry);
+   put('"');
+}
+void ExportBuffer :: put_dot(const std :: string & entry)
+{
+   put('"');
+   put_dot_escaped(entry.data(), entry.size());
+   put('"');
+}
+
+/*------------------------------------------------------------------------------
+Name:       put_escaped
+
+Purpose:    Append text escaped for a quoted JSON string. Quotes and
+            backslashes get a backslash, control characters are written as
+            \u escapes.
+
+Parameters: text:   text to escape, need not be null terminated
+            length: amount of characters in text
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_escaped(const char * text,
+                                 std :: string :: size_type length)
+{
+   static const char HEX[] = "0123456789abcdef"; /* digits of \u escapes */
+
+   for(std :: string :: size_type i = 0; i < length; ++i)
+   {
+      unsigned char letter = text[i]; /* character being escaped */
+
+      /* quote and backslash */
+      if(letter == '"' || letter == '\\')
+      {
+         buffer.push_back('\\');
+         buffer.push_back(letter);
+      }
+      /* control characters */
+      else if(letter < 0x20)
+      {
+         buffer.append("\\u00");
+         buffer.push_back(HEX[letter >> 4]);
+         buffer.push_back(HEX[letter & 0xf]);
+      }
+      else
+         buffer.push_back(letter);
+   }
+
+   if(buffer.size() >= CAPACITY)
+      flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       put_dot_escaped
+
+Purpose:    Append text escaped for a quoted DOT label. Quotes and backslashes
+            get a backslash and a newline becomes the \n line break of a label.
+            Graphviz reads &...; as a character entity, so & is written as
+            &amp; and other control characters as numeric entities.
+
+Parameters: text:   text to escape, need not be null terminated
+            length: amount of characters in text
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: put_dot_escaped(const char * text,
+                                     std :: string :: size_type length)
+{
+   for(std :: string :: size_type i = 0; i < length; ++i)
+   {
+      unsigned char letter = text[i]; /* character being escaped */
+
+      /* quote and backslash */
+      if(letter == '"' || letter == '\\')
+      {
+         buffer.push_back('\\');
+         buffer.push_back(letter);
+      }
+      /* line break */
+      else if(letter == '\n')
+         buffer.append("\\n");
+      /* entity start */
+      else if(letter == '&')
+         buffer.append("&amp;");
+      /* other control characters */
+      else if(letter < 0x20)
+      {
+         buffer.append("&#");
+         append_number(buffer, (unsigned int)letter);
+         buffer.push_back(';');
+      }
+      else
+         buffer.push_back(letter);
+   }
+
+   if(buffer.size() >= CAPACITY)
+      flush();
+}
+
+/*------------------------------------------------------------------------------
+Name:       flush
+
+Purpose:    Write the buffer to the stream in one block and empty it. The stream
+            is left to flush itself.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void ExportBuffer :: flush()
+{
+   out.write(buffer.data(), buffer.size());
+   buffer.clear();
+}
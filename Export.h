@@ -0,0 +1,100 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Export.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the export buffer used to dump a tree. Text
+         is gathered in a large buffer and written to the stream in big blocks
+         with no flush per line, so dumping a large tree costs little more than
+         walking it. Entries of every type the tree is defined for can be
+         written as plain text, as exact text, as a JSON value or as a quoted
+         DOT label.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef EXPORT_H
+#define EXPORT_H
+#include<ostream>
+#include<string>
+
+/* formats a tree can be exported in */
+enum ExportFormat
+{
+   EXPORT_KEYS,  /* entries in ascending order, one per line, in full */
+   EXPORT_NODES, /* tree attributes and every node as print_tree lists them */
+   EXPORT_DOT,   /* Graphviz digraph of the tree structure */
+   EXPORT_JSON   /* tree attributes and nested node objects */
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        ExportBuffer
+
+Purpose:     Gather text for a stream and write it in large blocks.
+
+Data Fields: out:    stream the text ends up in
+             buffer: text not yet written
+
+Functions: ExportBuffer:  constructor
+           ~ExportBuffer: destructor, writes what is left
+           put:           append text or a number
+           put_entry:     append an entry as plain text
+           put_key:       append an entry as text reading back the same
+           put_json:      append an entry as a JSON value
+           put_dot:       append an entry as a quoted DOT label
+           put_escaped:   append text escaped for a quoted JSON string
+           put_dot_escaped: append text escaped for a quoted DOT label
+           flush:         write the buffer to the stream
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class ExportBuffer
+{
+   private:
+      /* data fields */
+      std :: ostream & out; /* stream the text ends up in */
+      std :: string buffer; /* text not yet written */
+
+   public:
+      static const unsigned int CAPACITY = 1 << 16; /* bytes held before a
+                                                       write */
+      /* functions */
+      ExportBuffer(std :: ostream &); /* constructor for a given stream */
+      ~ExportBuffer(void); /* destructor writing what is left */
+      void put(const char *); /* append text */
+      void put(char); /* append a character */
+      void put(unsigned int); /* append an unsigned number */
+      void put(int); /* append a signed number */
+      void put_entry(char); /* entries as plain text */
+      void put_entry(short);
+      void put_entry(int);
+      void put_entry(long);
+      void put_entry(float);
+      void put_entry(double);
+      void put_entry(const std :: string &);
+      void put_key(char); /* entries as text reading back the same */
+      void put_key(short);
+      void put_key(int);
+      void put_key(long);
+      void put_key(float);
+      void put_key(double);
+      void put_key(const std :: string &);
+      void put_json(char); /* entries as JSON values */
+      void put_json(short);
+      void put_json(int);
+      void put_json(long);
+      void put_json(float);
+      void put_json(double);
+      void put_json(const std :: string &);
+      void put_dot(char); /* entries as quoted DOT labels */
+      void put_dot(short);
+      void put_dot(int);
+      void put_dot(long);
+      void put_dot(float);
+      void put_dot(double);
+      void put_dot(const std :: string &);
+      void put_escaped(const char *, std :: string :: size_type); /* text
+                                             escaped for a quoted JSON string */
+      void put_dot_escaped(const char *, std :: string :: size_type); /* text
+                                              escaped for a quoted DOT label */
+      void flush(void); /* write the buffer to the stream */
+};
+
+#endif
@@ -0,0 +1,1128 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   FatTree.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains all the functions of the fat node tree. Each node
+         holds a cache line of sorted keys. Searching a node counts the keys
+         smaller than the entry, which is done with SIMD compares over the whole
+         line for int, long, float and double, and with a plain loop otherwise.
+         Unused slots are padded with the largest value of the type so they are
+         never counted. Inserting into a full node splits it in half and passes
+         a separator up to the parent, growing a new root when the root splits.
+         Removal takes the entry out of its leaf, a node left below half a line
+         borrows a key from a sibling or is merged with it, and a root left
+         with a single child is replaced by it. Entries are visited in order by
+         walking the chain of leaves, directly or through cursors.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "FatTree.h"
+#include<iostream>
+#include<fstream>
+#include<limits>
+#ifdef __SSE2__
+#include<immintrin.h>
+#endif
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       padding
+
+Purpose:    Value used for unused key slots. Nothing of the type compares
+            greater than it, so padded slots never count as smaller.
+
+Parameters: none
+
+Return:     largest value of the type, infinity when the type has one
+------------------------------------------------------------------------------*/
+static Data padding()
+{
+   if(std :: numeric_limits<Data> :: has_infinity)
+      return std :: numeric_limits<Data> :: infinity();
+
+   return std :: numeric_limits<Data> :: max();
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       FatNode
+
+Purpose:    Constructor for a fat node. No keys are in use and all slots are
+            padded.
+
+Parameters: leaf: whether this node is a leaf
+
+Return:     none
+------------------------------------------------------------------------------*/
+FatNode<Data> :: FatNode(bool leaf)
+{
+   next = prev = 0; /* not chained yet */
+   count = 0; /* no keys in use */
+   this->leaf = leaf; /* leaf or inner node */
+
+   /* children are null by default */
+   for(unsigned int i = 0; i <= SLOTS; ++i)
+      children[i] = 0;
+
+   pad();
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       pad
+
+Purpose:    Fill all key slots past count with the padding value so a full line
+            compare never counts them.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void FatNode<Data> :: pad()
+{
+   for(unsigned int i = count; i < SLOTS; ++i)
+      keys[i] = padding<Data>();
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       rank
+
+Purpose:    Count the keys of this node smaller than the entry. This is the slot
+            the entry belongs in within a leaf and the child to descend into
+            within an inner node. Types without a SIMD version use this loop.
+
+Parameters: entry: value to rank against the keys
+
+Return:     smaller: amount of keys smaller than the entry
+------------------------------------------------------------------------------*/
+unsigned int FatNode<Data> :: rank(Data entry)
+{
+   unsigned int smaller = 0; /* keys smaller than the entry */
+
+   /* keys are sorted so stop at the first one that is not smaller */
+   while(smaller < count && keys[smaller] < entry)
+      ++smaller;
+
+   return smaller;
+}
+
+#ifdef __SSE2__
+/*------------------------------------------------------------------------------
+Name:       rank
+
+Purpose:    SIMD rank for ints, compares four keys at a time across the line.
+
+Parameters: entry: value to rank against the keys
+
+Return:     smaller: amount of keys smaller than the entry
+------------------------------------------------------------------------------*/
+template<>
+unsigned int FatNode<int> :: rank(int entry)
+{
+   __m128i target = _mm_set1_epi32(entry); /* entry in every lane */
+   unsigned int smaller = 0; /* keys smaller than the entry */
+
+   /* each set lane of the mask is a key smaller than the entry */
+   for(unsigned int i = 0; i < SLOTS; i += 4)
+   {
+      __m128i block = _mm_load_si128((const __m128i *)(keys + i));
+      smaller += __builtin_popcount(_mm_movemask_ps(
+                    _mm_castsi128_ps(_mm_cmplt_epi32(block, target))));
+   }
+
+   return smaller;
+}
+
+/*------------------------------------------------------------------------------
+Name:       rank
+
+Purpose:    SIMD rank for floats, compares four keys at a time across the line.
+
+Parameters: entry: value to rank against the keys
+
+Return:     smaller: amount of keys smaller than the entry
+------------------------------------------------------------------------------*/
+template<>
+unsigned int FatNode<float> :: rank(float entry)
+{
+   __m128 target = _mm_set1_ps(entry); /* entry in every lane */
+   unsigned int smaller = 0; /* keys smaller than the entry */
+
+   /* each set lane of the mask is a key smaller than the entry */
+   for(unsigned int i = 0; i < SLOTS; i += 4)
+      smaller += __builtin_popcount(_mm_movemask_ps(
+                    _mm_cmplt_ps(_mm_load_ps(keys + i), target)));
+
+   return smaller;
+}
+
+/*------------------------------------------------------------------------------
+Name:       rank
+
+Purpose:    SIMD rank for doubles, compares two keys at a time across the line.
+
+Parameters: entry: value to rank against the keys
+
+Return:     smaller: amount of keys smaller than the entry
+------------------------------------------------------------------------------*/
+template<>
+unsigned int FatNode<double> :: rank(double entry)
+{
+   __m128d target = _mm_set1_pd(entry); /* entry in every lane */
+   unsigned int smaller = 0; /* keys smaller than the entry */
+
+   /* each set lane of the mask is a key smaller than the entry */
+   for(unsigned int i = 0; i < SLOTS; i += 2)
+      smaller += __builtin_popcount(_mm_movemask_pd(
+                    _mm_cmplt_pd(_mm_load_pd(keys + i), target)));
+
+   return smaller;
+}
+
+#if defined(__SSE4_2__) && defined(__LP64__)
+/*------------------------------------------------------------------------------
+Name:       rank
+
+Purpose:    SIMD rank for longs, compares two keys at a time across the line.
+            64 bit compares need SSE4.2, build with -msse4.2 to use it.
+
+Parameters: entry: value to rank against the keys
+
+Return:     smaller: amount of keys smaller than the entry
+------------------------------------------------------------------------------*/
+template<>
+unsigned int FatNode<long> :: rank(long entry)
+{
+   __m128i target = _mm_set1_epi64x(entry); /* entry in every lane */
+   unsigned int smaller = 0; /* keys smaller than the entry */
+
+   /* each set lane of the mask is a key smaller than the entry */
+   for(unsigned int i = 0; i < SLOTS; i += 2)
+   {
+      __m128i block = _mm_load_si128((const __m128i *)(keys + i));
+      smaller += __builtin_popcount(_mm_movemask_pd(
+                    _mm_castsi128_pd(_mm_cmpgt_epi64(target, block))));
+   }
+
+   return smaller;
+}
+#endif
+#endif
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       FatTree
+
+Purpose:    FatTree constructor for this object, starts with an empty leaf as
+            the root.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+FatTree<Data> :: FatTree()
+{
+   root = new FatNode<Data>(true);
+   occupancy = 0;
+   height = nodes = 1;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       ~FatTree
+
+Purpose:    destructor for this tree, calls delete_nodes to delete this tree
+            node by node starting from the root
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+FatTree<Data> :: ~FatTree()
+{
+   /* delegate to function that deletes the nodes of this tree */
+   delete_nodes(root);
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       insert_into
+
+Purpose:    Insert the entry below the given node. Keys are merged into a line
+            one slot longer than a node, which is copied back when it fits and
+            otherwise split in half into a new right sibling. A leaf passes up
+            the largest key of its left half, an inner node passes up its middle
+            key.
+
+Parameters: node:  node to insert below
+            entry: value to be inserted
+            sep:   set to the separator to add to the parent upon a split
+            right: set to the new right sibling upon a split, null otherwise
+
+Return:     inserted: false if the entry was already in the tree
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: insert_into(FatNode<Data> * node, Data entry, Data & sep,
+                                  FatNode<Data> * & right)
+{
+   const unsigned int SLOTS = FatNode<Data> :: SLOTS; /* keys per node */
+   Data merged[SLOTS + 1]; /* keys of the node plus the one being added */
+   FatNode<Data> * links[SLOTS + 2]; /* children of the node plus the new one */
+   unsigned int pos = node->rank(entry); /* slot or child for the entry */
+   unsigned int total = node->count + 1; /* keys after adding one */
+
+   right = 0; /* no split unless the node overflows */
+
+   if(node->leaf)
+   {
+      /* duplicate insert is not allowed */
+      if(pos < node->count && node->keys[pos] == entry)
+         return false;
+
+      /* merge the entry into its slot */
+      for(unsigned int i = 0, j = 0; i < total; ++i)
+         merged[i] = (i == pos) ? entry : node->keys[j++];
+
+      ++occupancy;
+   }
+   else
+   {
+      Data child_sep; /* separator passed up by the child */
+      FatNode<Data> * child_right; /* new sibling of the child */
+
+      /* descend, nothing to do here unless the child split */
+      if(!insert_into(node->children[pos], entry, child_sep, child_right))
+         return false;
+      if(!child_right)
+         return true;
+
+      /* separator goes in slot pos, new sibling right after the child */
+      for(unsigned int i = 0, j = 0; i < total; ++i)
+         merged[i] = (i == pos) ? child_sep : node->keys[j++];
+      for(unsigned int i = 0, j = 0; i <= total; ++i)
+         links[i] = (i == pos + 1) ? child_right : node->children[j++];
+   }
+
+   /* merged line fits, copy it back */
+   if(total <= SLOTS)
+   {
+      for(unsigned int i = 0; i < total; ++i)
+         node->keys[i] = merged[i];
+      if(!node->leaf)
+         for(unsigned int i = 0; i <= total; ++i)
+            node->children[i] = links[i];
+
+      node->count = total;
+      return true;
+   }
+
+   /* split the merged line between this node and a new right sibling */
+   unsigned int half = total / 2; /* keys kept by this node */
+   right = new FatNode<Data>(node->leaf);
+   ++nodes;
+
+   if(node->leaf)
+   {
+      /* leaf keeps every key, separator is its largest */
+      for(unsigned int i = 0; i < half; ++i)
+         node->keys[i] = merged[i];
+      for(unsigned int i = half; i < total; ++i)
+         right->keys[i - half] = merged[i];
+
+      node->count = half;
+      right->count = total - half;
+      sep = merged[half - 1];
+
+      /* chain the new leaf in after this one */
+      right->next = node->next;
+      right->prev = node;
+      if(node->next)
+         node->next->prev = right;
+      node->next = right;
+   }
+   else
+   {
+      /* middle key moves up to the parent */
+      for(unsigned int i = 0; i < half; ++i)
+         node->keys[i] = merged[i];
+      for(unsigned int i = half + 1; i < total; ++i)
+         right->keys[i - half - 1] = merged[i];
+      for(unsigned int i = 0; i <= total; ++i)
+      {
+         if(i <= half)
+            node->children[i] = links[i];
+         else
+            right->children[i - half - 1] = links[i];
+      }
+      for(unsigned int i = half + 1; i <= SLOTS; ++i)
+         node->children[i] = 0;
+
+      node->count = half;
+      right->count = total - half - 1;
+      sep = merged[half];
+   }
+
+   node->pad();
+   right->pad();
+   return true;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       insert
+
+Purpose:    Insert the entry into its leaf, splitting full nodes on the way
+            back up. A split of the root grows the tree by one level.
+            Duplicate insert is not allowed and will cause this function to
+            return false.
+
+Parameters: entry: the data value via generic to be inserted
+
+Return:     inserted: sucess or failure of insertion of the given entry
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: insert(Data entry)
+{
+   Data sep; /* separator passed up by the root */
+   FatNode<Data> * right; /* new sibling of the root */
+
+   /* insert below the root */
+   if(!insert_into(root, entry, sep, right))
+      return false;
+
+   /* root was split, put a new root above both halves */
+   if(right)
+   {
+      FatNode<Data> * new_root = new FatNode<Data>(false);
+      new_root->keys[0] = sep;
+      new_root->children[0] = root;
+      new_root->children[1] = right;
+      new_root->count = 1;
+      root = new_root;
+      ++nodes;
+      ++height;
+   }
+
+   return true;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       remove_from
+
+Purpose:    Remove the entry below the given node. On the way back up each
+            node refills the child it descended into if that child dropped
+            below half a line.
+
+Parameters: node:  node to remove below
+            entry: value to be removed
+
+Return:     removed: false if the entry was not in the tree
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: remove_from(FatNode<Data> * node, Data entry)
+{
+   unsigned int pos = node->rank(entry); /* slot or child of the entry */
+
+   if(node->leaf)
+   {
+      /* entry not in the tree */
+      if(pos >= node->count || node->keys[pos] != entry)
+         return false;
+
+      /* close the gap and pad the freed slot */
+      for(unsigned int i = pos + 1; i < node->count; ++i)
+         node->keys[i - 1] = node->keys[i];
+
+      --node->count;
+      node->pad();
+      --occupancy;
+
+      return true;
+   }
+
+   /* descend, then refill the child if it ran low */
+   if(!remove_from(node->children[pos], entry))
+      return false;
+
+   if(node->children[pos]->count < FatNode<Data> :: HALF)
+      rebalance(node, pos);
+
+   return true;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       rebalance
+
+Purpose:    Refill a child that dropped below half a line. A sibling with keys
+            to spare lends its nearest one, otherwise the child and a sibling
+            are merged into one node and the separator between them is
+            dropped from the parent. Leaves move keys directly and keep the
+            largest key of the left leaf as separator, inner nodes rotate keys
+            through the separator in the parent. Both halves together stay
+            within a line, one is below half and the other at most half.
+
+Parameters: parent: node holding the child
+            pos:    index of the child running low
+
+Return:     void
+------------------------------------------------------------------------------*/
+void FatTree<Data> :: rebalance(FatNode<Data> * parent, unsigned int pos)
+{
+   const unsigned int HALF = FatNode<Data> :: HALF; /* fewest keys allowed */
+   FatNode<Data> * child = parent->children[pos]; /* node running low */
+   FatNode<Data> * left = pos > 0 ? parent->children[pos - 1] : 0;
+   FatNode<Data> * right = pos < parent->count ? parent->children[pos + 1] : 0;
+
+   /* left sibling lends its largest key */
+   if(left && left->count > HALF)
+   {
+      for(unsigned int i = child->count; i > 0; --i)
+         child->keys[i] = child->keys[i - 1];
+
+      if(child->leaf)
+      {
+         child->keys[0] = left->keys[left->count - 1];
+         parent->keys[pos - 1] = left->keys[left->count - 2];
+      }
+      else
+      {
+         for(unsigned int i = child->count + 1; i > 0; --i)
+            child->children[i] = child->children[i - 1];
+
+         child->keys[0] = parent->keys[pos - 1];
+         child->children[0] = left->children[left->count];
+         parent->keys[pos - 1] = left->keys[left->count - 1];
+         left->children[left->count] = 0;
+      }
+
+      ++child->count;
+      --left->count;
+      left->pad();
+      return;
+   }
+
+   /* right sibling lends its smallest key */
+   if(right && right->count > HALF)
+   {
+      if(child->leaf)
+      {
+         child->keys[child->count] = right->keys[0];
+         parent->keys[pos] = right->keys[0];
+      }
+      else
+      {
+         child->keys[child->count] = parent->keys[pos];
+         child->children[child->count + 1] = right->children[0];
+         parent->keys[pos] = right->keys[0];
+
+         for(unsigned int i = 1; i <= right->count; ++i)
+            right->children[i - 1] = right->children[i];
+         right->children[right->count] = 0;
+      }
+
+      for(unsigned int i = 1; i < right->count; ++i)
+         right->keys[i - 1] = right->keys[i];
+
+      ++child->count;
+      --right->count;
+      right->pad();
+      return;
+   }
+
+   /* no key to spare, merge into the left one of the pair */
+   if(!left)
+   {
+      left = child;
+      child = right;
+      ++pos;
+   }
+
+   /* only child of the root, the root is lowered by remove */
+   if(!child)
+      return;
+
+   if(child->leaf)
+   {
+      for(unsigned int i = 0; i < child->count; ++i)
+         left->keys[left->count + i] = child->keys[i];
+
+      left->count += child->count;
+
+      /* unchain the merged leaf */
+      left->next = child->next;
+      if(child->next)
+         child->next->prev = left;
+   }
+   else
+   {
+      /* separator comes down between the two halves */
+      left->keys[left->count] = parent->keys[pos - 1];
+
+      for(unsigned int i = 0; i < child->count; ++i)
+         left->keys[left->count + 1 + i] = child->keys[i];
+      for(unsigned int i = 0; i <= child->count; ++i)
+         left->children[left->count + 1 + i] = child->children[i];
+
+      left->count += child->count + 1;
+   }
+
+   /* drop the separator and the merged child from the parent */
+   for(unsigned int i = pos; i < parent->count; ++i)
+      parent->keys[i - 1] = parent->keys[i];
+   for(unsigned int i = pos + 1; i <= parent->count; ++i)
+      parent->children[i - 1] = parent->children[i];
+
+   parent->children[parent->count] = 0;
+   --parent->count;
+   parent->pad();
+
+   delete child;
+   --nodes;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       remove
+
+Purpose:    Remove the entry from its leaf, refilling nodes that run low on the
+            way back up. A root left with one child is replaced by that child,
+            shrinking the tree by one level. Removal will fail if the given
+            entry is not in the tree.
+
+Parameters: entry: the data value via generic looking for removal
+
+Return:     removed: status of whether the entry was removed
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: remove(Data entry)
+{
+   /* remove below the root */
+   if(!remove_from(root, entry))
+      return false;
+
+   /* root with a single child is not needed, lower the tree */
+   while(!root->leaf && root->count == 0)
+   {
+      FatNode<Data> * old_root = root; /* root being replaced */
+
+      root = root->children[0];
+      delete old_root;
+      --nodes;
+      --height;
+   }
+
+   return true;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       find
+
+Purpose:    search for an entry in this tree to see whether or not it exists,
+            one rank per level
+
+Parameters: entry: entry to be searched for
+
+Return:     found: status of whether the entry is in the tree
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: find(Data entry)
+{
+   FatNode<Data> * node = root; /* node being searched */
+
+   /* descend to the leaf that would hold the entry */
+   while(!node->leaf)
+      node = node->children[node->rank(entry)];
+
+   unsigned int pos = node->rank(entry); /* slot of the entry */
+
+   return pos < node->count && node->keys[pos] == entry;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       delete_nodes
+
+Purpose:    Recursive post order deletion of all nodes in the tree.
+
+Parameters: node: should be the root node for all nodes to be sucessfully freed
+                  from the tree
+
+Return:     void
+------------------------------------------------------------------------------*/
+void FatTree<Data> :: delete_nodes(FatNode<Data> * node)
+{
+   /* return if the tree is already empty */
+   if(!node)
+      return;
+
+   /* post order deletion, children then delete */
+   if(!node->leaf)
+      for(unsigned int i = 0; i <= node->count; ++i)
+         delete_nodes(node->children[i]);
+
+   delete node;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       range
+
+Purpose:    Count the entries from low to high, both included. The search goes
+            down to the slot of low in its leaf, then follows the chain of
+            leaves until a key passes high.
+
+Parameters: low:  smallest entry counted
+            high: largest entry counted
+
+Return:     found: entries in the range
+------------------------------------------------------------------------------*/
+unsigned int FatTree<Data> :: range(Data low, Data high)
+{
+   FatNode<Data> * node = root; /* node being searched */
+   unsigned int found = 0; /* entries in the range */
+
+   /* descend to the leaf that would hold low */
+   while(!node->leaf)
+      node = node->children[node->rank(low)];
+
+   /* count keys in order until one passes high */
+   for(unsigned int i = node->rank(low); node; node = node->next, i = 0)
+      for(; i < node->count; ++i, ++found)
+         if(high < node->keys[i])
+            return found;
+
+   return found;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       count
+
+Purpose:    Occurrences of the given entry in this tree, duplicates are not
+            kept so this is either 0 or 1.
+
+Parameters: entry: entry to count
+
+Return:     occurrences of the entry
+------------------------------------------------------------------------------*/
+unsigned int FatTree<Data> :: count(Data entry)
+{
+   return find(entry) ? 1 : 0;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       size
+
+Purpose:    Amount of entries in this tree.
+
+Parameters: none
+
+Return:     occupancy: entries in the tree
+------------------------------------------------------------------------------*/
+unsigned int FatTree<Data> :: size()
+{
+   return occupancy;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       tree_height
+
+Purpose:    Height of this tree, the amount of levels from the root to a leaf.
+
+Parameters: none
+
+Return:     height: levels in the tree
+------------------------------------------------------------------------------*/
+unsigned int FatTree<Data> :: tree_height()
+{
+   return height;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       first_leaf
+
+Purpose:    Return the leftmost leaf. Following next from it visits every entry
+            in ascending order.
+
+Parameters: none
+
+Return:     node: leaf holding the smallest entries
+------------------------------------------------------------------------------*/
+FatNode<Data> * FatTree<Data> :: first_leaf()
+{
+   FatNode<Data> * node = root; /* start at the root */
+
+   /* go as left as possible */
+   while(!node->leaf)
+      node = node->children[0];
+
+   return node;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       first_node
+
+Purpose:    Return a cursor on the smallest entry of the tree, the first slot
+            of the leftmost leaf. Matches first_node of the tree class.
+
+Parameters: tree: this tree
+
+Return:     cursor of the smallest entry, false if the tree is empty
+------------------------------------------------------------------------------*/
+FatCursor<Data> FatTree<Data> :: first_node(FatTree<Data> * tree)
+{
+   return FatCursor<Data>(tree->first_leaf(), 0);
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       FatCursor
+
+Purpose:    Constructor for a cursor on a slot of a leaf. A slot past the keys
+            in use gives a cursor past the last entry.
+
+Parameters: leaf: leaf holding the entry
+            slot: slot of the entry in the leaf
+
+Return:     none
+------------------------------------------------------------------------------*/
+FatCursor<Data> :: FatCursor(FatNode<Data> * leaf, unsigned int slot)
+{
+   /* past the last entry */
+   if(!leaf || slot >= leaf->count)
+   {
+      this->leaf = 0;
+      this->slot = 0;
+      entry = Data();
+      count = 0;
+      return;
+   }
+
+   this->leaf = leaf;
+   this->slot = slot;
+   entry = leaf->keys[slot];
+   count = 1;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       operator->
+
+Purpose:    The cursor itself, so members are reached with -> as on a node.
+
+Parameters: none
+
+Return:     this cursor
+------------------------------------------------------------------------------*/
+FatCursor<Data> * FatCursor<Data> :: operator->()
+{
+   return this;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       operator bool
+
+Purpose:    Whether the cursor is on an entry, false past the last one as a
+            null node is.
+
+Parameters: none
+
+Return:     cursor is on an entry
+------------------------------------------------------------------------------*/
+FatCursor<Data> :: operator bool() const
+{
+   return leaf != 0;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       sucessor
+
+Purpose:    Cursor of the next entry in ascending order, the next slot of the
+            leaf or the first slot of the next leaf. Only the root can be an
+            empty leaf, so the next leaf always has an entry.
+
+Parameters: node: cursor to find the sucessor of
+
+Return:     cursor of the sucessor, false if there is none
+------------------------------------------------------------------------------*/
+FatCursor<Data> FatCursor<Data> :: sucessor(FatCursor<Data> node)
+{
+   /* last entry of its leaf, move on to the next leaf */
+   if(node.slot + 1 >= node.leaf->count)
+      return FatCursor<Data>(node.leaf->next, 0);
+
+   return FatCursor<Data>(node.leaf, node.slot + 1);
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_fat_node
+
+Purpose:    Write a node and the nodes below it in pre order, one line each
+            with its kind, level, count and keys. Recursion is as deep as the
+            tree has levels, which stays small.
+
+Parameters: buffer: buffer to write to
+            node:   top node to write
+            level:  steps from the root to the node
+            number: number of the node within the listing, counted up
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void export_fat_node(ExportBuffer & buffer, FatNode<Data> * node,
+                            unsigned int level, unsigned int & number)
+{
+   /* data fields of the node */
+   buffer.put(number++);
+   buffer.put(node->leaf ? ". leaf" : ". inner");
+   buffer.put(" :: level: ");
+   buffer.put(level);
+   buffer.put(" :: count: ");
+   buffer.put(node->count);
+   buffer.put(" :: keys:");
+
+   for(unsigned int i = 0; i < node->count; ++i)
+   {
+      buffer.put(' ');
+      buffer.put_entry(node->keys[i]);
+   }
+
+   buffer.put('\n');
+
+   /* children from left to right */
+   if(!node->leaf)
+      for(unsigned int i = 0; i <= node->count; ++i)
+         export_fat_node(buffer, node->children[i], level + 1, number);
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_fat_dot
+
+Purpose:    Write a node and the nodes below it as Graphviz records, the keys
+            of a node separated by |, with an edge to each child. Nodes are
+            named by their number in pre order.
+
+Parameters: buffer: buffer to write to
+            node:   top node to write
+            number: number of the next node, counted up
+
+Return:     id: number given to the node
+------------------------------------------------------------------------------*/
+static unsigned int export_fat_dot(ExportBuffer & buffer, FatNode<Data> * node,
+                                   unsigned int & number)
+{
+   unsigned int id = number++; /* number of this node */
+
+   buffer.put("   n");
+   buffer.put(id);
+   buffer.put(" [label=\"");
+   for(unsigned int i = 0; i < node->count; ++i)
+   {
+      if(i)
+         buffer.put('|');
+      buffer.put_key(node->keys[i]);
+   }
+   buffer.put("\"];\n");
+
+   /* edge to each child, named once it is written */
+   if(!node->leaf)
+      for(unsigned int i = 0; i <= node->count; ++i)
+      {
+         unsigned int child = export_fat_dot(buffer, node->children[i],
+                                             number); /* number of the child */
+
+         buffer.put("   n");
+         buffer.put(id);
+         buffer.put(" -> n");
+         buffer.put(child);
+         buffer.put(";\n");
+      }
+
+   return id;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_fat_json
+
+Purpose:    Write a node and the nodes below it as nested JSON objects holding
+            the keys of the node and, for inner nodes, its children.
+
+Parameters: buffer: buffer to write to
+            node:   top node to write
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void export_fat_json(ExportBuffer & buffer, FatNode<Data> * node)
+{
+   buffer.put(node->leaf ? "{\"leaf\":true" : "{\"leaf\":false");
+   buffer.put(",\"keys\":[");
+   for(unsigned int i = 0; i < node->count; ++i)
+   {
+      if(i)
+         buffer.put(',');
+      buffer.put_json(node->keys[i]);
+   }
+   buffer.put(']');
+
+   /* children from left to right */
+   if(!node->leaf)
+   {
+      buffer.put(",\"children\":[");
+      for(unsigned int i = 0; i <= node->count; ++i)
+      {
+         if(i)
+            buffer.put(',');
+         export_fat_json(buffer, node->children[i]);
+      }
+      buffer.put(']');
+   }
+
+   buffer.put('}');
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_tree
+
+Purpose:    Write this tree to a stream in the given format, in the formats of
+            the tree class. EXPORT_KEYS lists entries in ascending order.
+            EXPORT_NODES lists the tree attributes and every fat node in pre
+            order as print_tree does. EXPORT_DOT writes a Graphviz digraph of
+            record nodes. EXPORT_JSON writes the tree attributes and the nodes
+            nested from the root.
+
+Parameters: out:    stream to write to
+            format: format to write in
+
+Return:     void
+------------------------------------------------------------------------------*/
+void FatTree<Data> :: export_tree(std :: ostream & out, ExportFormat format)
+{
+   ExportBuffer buffer(out); /* buffer writing to the stream */
+   unsigned int number = 1; /* starting count */
+
+   switch(format)
+   {
+      case EXPORT_KEYS:
+         /* walk the leaf chain writing every entry in order */
+         for(FatNode<Data> * node = first_leaf(); node; node = node->next)
+            for(unsigned int i = 0; i < node->count; ++i)
+            {
+               buffer.put_key(node->keys[i]);
+               buffer.put('\n');
+            }
+         break;
+
+      case EXPORT_NODES:
+         /* tree datafields */
+         buffer.put("Tree attributes :: occupancy: ");
+         buffer.put(occupancy);
+         buffer.put(" :: height: ");
+         buffer.put(height);
+         buffer.put(" :: nodes: ");
+         buffer.put(nodes);
+         buffer.put(" :: keys per node: ");
+         buffer.put(FatNode<Data> :: SLOTS);
+         buffer.put("\n\n");
+
+         /* if tree is empty, say so */
+         if(occupancy == 0)
+            buffer.put("The tree is empty!\n");
+         else
+            export_fat_node(buffer, root, 0, number);
+         break;
+
+      case EXPORT_DOT:
+         buffer.put("digraph tree {\n   node [shape=record];\n");
+         number = 0;
+         if(occupancy)
+            export_fat_dot(buffer, root, number);
+         buffer.put("}\n");
+         break;
+
+      case EXPORT_JSON:
+         /* tree datafields */
+         buffer.put("{\"occupancy\":");
+         buffer.put(occupancy);
+         buffer.put(",\"height\":");
+         buffer.put(height);
+         buffer.put(",\"nodes\":");
+         buffer.put(nodes);
+         buffer.put(",\"root\":");
+
+         /* nodes nested from the root */
+         if(occupancy)
+            export_fat_json(buffer, root);
+         else
+            buffer.put("null");
+
+         buffer.put("}\n");
+         break;
+   }
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_tree
+
+Purpose:    Write this tree to a file in the given format, replacing the file if
+            it exists.
+
+Parameters: filename: name of the file to write
+            format:   format to write in
+
+Return:     written: whether the file could be opened and written
+------------------------------------------------------------------------------*/
+bool FatTree<Data> :: export_tree(const char * filename, ExportFormat format)
+{
+   std :: ofstream fio(filename, std :: ios :: binary); /* output file */
+
+   /* file could not be opened */
+   if(!fio.is_open())
+      return false;
+
+   export_tree(fio, format);
+   fio.close();
+
+   return !fio.fail();
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       print_tree
+
+Purpose:    Print every fat node of the tree in pre order along with the
+            datafields of the tree itself.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void FatTree<Data> :: print_tree()
+{
+   /* delegate to the buffered export, flush once at the end */
+   export_tree(std :: cout, EXPORT_NODES);
+   std :: cout.flush();
+}
+
+/* define all arithmetic types for the template classes */
+template class FatNode<int>; /* node holding ints */
+template class FatNode<float>; /* node holding floats */
+template class FatNode<double>; /* node holding doubles */
+template class FatNode<long>; /* node holding longs */
+template class FatCursor<int>; /* cursor over ints */
+template class FatCursor<float>; /* cursor over floats */
+template class FatCursor<double>; /* cursor over doubles */
+template class FatCursor<long>; /* cursor over longs */
+template class FatTree<int>; /* tree of ints */
+template class FatTree<float>; /* tree of floats */
+template class FatTree<double>; /* tree of doubles */
+template class FatTree<long>; /* tree of longs */
@@ -0,0 +1,173 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   FatTree.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the fat node tree, an alternative engine for
+         arithmetic keys. Instead of one entry per node, every node packs a full
+         cache line of sorted keys that are searched all at once with SIMD
+         compares, so a lookup misses the cache once per level instead of once
+         per comparison. The public functions match those of the tree class,
+         a cursor stands in for its node pointers so the same loop walks
+         either one:
+
+         for(auto node = tree.first_node(&tree); node;
+             node = node->sucessor(node))
+            std :: cout << node->entry << '\n';
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef FATTREE_H
+#define FATTREE_H
+#include "Export.h"
+
+static const unsigned int CACHE_LINE = 64; /* bytes in one cache line */
+
+template<typename Data> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        FatNode
+
+Purpose:     Hold a cache line of sorted keys. Leaves hold the entries of the
+             tree and are chained both ways in ascending order. Inner nodes hold
+             separators, child i holds entries greater than keys[i - 1] and no
+             greater than keys[i].
+
+Data Fields: keys:     sorted keys, unused slots padded with the largest value
+             children: child pointers, unused by leaves
+             next:     next leaf in ascending order
+             prev:     previous leaf in ascending order
+             count:    keys in use
+             leaf:     whether this node is a leaf
+
+Functions: FatNode: constructor
+           rank:    amount of keys smaller than a given entry
+           pad:     fill unused key slots with the largest value
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class FatNode
+{
+   public:
+      static const unsigned int SLOTS = CACHE_LINE / sizeof(Data); /* keys per
+                                                                      node */
+      static const unsigned int HALF = SLOTS / 2; /* fewest keys of a node
+                                                     other than the root */
+      /* data fields */
+      alignas(CACHE_LINE) Data keys[SLOTS]; /* sorted keys on one line */
+      FatNode<Data> * children[SLOTS + 1];  /* children of an inner node */
+      FatNode<Data> * next;                 /* next leaf in ascending order */
+      FatNode<Data> * prev;                 /* previous leaf in ascending order
+                                               */
+      unsigned int count;                   /* keys in use */
+      bool leaf;                            /* leaf or inner node */
+
+      /* functions */
+      FatNode(bool); /* constructor for a leaf or inner node */
+      unsigned int rank(Data); /* amount of keys smaller than the entry */
+      void pad(void); /* pad unused key slots */
+};
+
+template<typename Data> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        FatCursor
+
+Purpose:     Position of one entry in the fat node tree, used like a node
+             pointer of the tree class. It points to itself, and a cursor past
+             the last entry converts to false like a null node.
+
+Data Fields: leaf:  leaf holding the entry, null past the last entry
+             slot:  slot of the entry in its leaf
+             entry: copy of the entry
+             count: occurrences of the entry, always 1
+
+Functions: FatCursor: constructor
+           ->:        the cursor itself
+           bool:      whether the cursor is on an entry
+           sucessor:  cursor of the next entry in ascending order
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class FatCursor
+{
+   public:
+      /* data fields */
+      FatNode<Data> * leaf; /* leaf holding the entry */
+      unsigned int slot;    /* slot of the entry in its leaf */
+      Data entry;           /* copy of the entry */
+      unsigned int count;   /* occurrences of the entry */
+
+      /* functions */
+      FatCursor(FatNode<Data> *, unsigned int); /* constructor for a slot */
+      FatCursor<Data> * operator->(void); /* the cursor itself */
+      explicit operator bool(void) const; /* cursor is on an entry */
+      FatCursor<Data> sucessor(FatCursor<Data>); /* find next entry in
+                                                    ascending order */
+};
+
+template<typename Data> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        FatTree
+
+Purpose:     B-tree style data structure made up of fat nodes. Every node but
+             the root keeps at least half a line of keys: removal borrows a key
+             from a sibling when a node drops below that, or merges the two
+             when the sibling has none to spare, so lines stay dense after
+             heavy deletion.
+
+Data Fields: occupancy: amount of entries in tree
+             height:    amount of levels in the tree
+             nodes:     amount of fat nodes allocated
+             root:      top node in the tree
+
+Functions: FatTree:      constructor
+           ~FatTree:     destructor
+           insert:       add entries
+           remove:       take out entries
+           find:         look for an entry
+           range:        entries between two entries
+           count:        occurrences of an entry
+           size:         amount of entries
+           tree_height:  amount of levels in the tree
+           delete_nodes: delete tree node by node
+           first_leaf:   return leaf carrying smallest values
+           first_node:   return cursor of the smallest entry
+           export_tree:  write the tree to a stream or file in a given format
+           print_tree:   print tree attributes and all its nodes
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class FatTree
+{
+   private:
+      /* data fields */
+      unsigned int occupancy, /* entries in tree */
+                   height,    /* amount of levels */
+                   nodes;     /* fat nodes allocated */
+
+      FatNode<Data> * root;   /* first node in the tree */
+
+      /* functions */
+      bool insert_into(FatNode<Data> *, Data, Data &, FatNode<Data> * &);
+                              /* add entry below a node, report any split */
+      bool remove_from(FatNode<Data> *, Data); /* take entry out below a node
+                                                */
+      void rebalance(FatNode<Data> *, unsigned int); /* refill a child below
+                                                        half a line */
+      FatNode<Data> * first_leaf(void); /* return leaf of smallest entries */
+
+   public:
+      /* functions */
+      FatTree(void); /* constructor for defining a tree */
+      ~FatTree(void); /* destructor that deletes the tree by nodes */
+      bool insert(Data); /* add entries */
+      bool remove(Data); /* take out entries */
+      bool find(Data); /* look for entries */
+      unsigned int range(Data, Data); /* entries from low to high */
+      unsigned int count(Data); /* occurrences of an entry */
+      unsigned int size(void); /* amount of entries */
+      unsigned int tree_height(void); /* amount of levels */
+      void delete_nodes(FatNode<Data> *); /* delete all the nodes in the tree */
+      FatCursor<Data> first_node(FatTree<Data> *); /* return cursor of smallest
+                                                      entry */
+      void export_tree(std :: ostream &, ExportFormat); /* buffered dump of
+                                                           the tree */
+      bool export_tree(const char *, ExportFormat); /* dump the tree to a file
+                                                      */
+      void print_tree(void); /* print tree attributes and all its nodes */
+};
+
+#endif
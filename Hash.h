@@ -0,0 +1,40 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Hash.h
+--------------------------------------------------------------------------------
+Purpose: Hash of an entry for the structures kept alongside a tree. The
+         standard hash of many types is the value itself, so it is mixed until
+         every bit of the result depends on every bit of the entry.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef HASH_H
+#define HASH_H
+#include<functional>
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       hash_entry
+
+Purpose:    Hash an entry with the standard hash and mix the result with the
+            splitmix64 finalizer.
+
+Parameters: entry: entry to hash
+
+Return:     hash: mixed 64 bit hash of the entry
+------------------------------------------------------------------------------*/
+inline unsigned long long hash_entry(const Data & entry)
+{
+   unsigned long long hash = std :: hash<Data>()(entry);
+
+   hash ^= hash >> 30;
+   hash *= 0xbf58476d1ce4e5b9ULL;
+   hash ^= hash >> 27;
+   hash *= 0x94d049bb133111ebULL;
+   hash ^= hash >> 31;
+
+   return hash;
+}
+
+#endif
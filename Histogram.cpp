@@ -0,0 +1,136 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Histogram.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains the functions of the latency histogram. Values
+         below SUB_BUCKETS get a bucket each. Larger values are bucketed by the
+         position of their highest set bit and the SUB_BITS bits after it. A
+         percentile walks the buckets until enough samples are counted and
+         returns the largest value of the bucket it stops in.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "Histogram.h"
+#include<cmath>
+
+/*------------------------------------------------------------------------------
+Name:       Histogram
+
+Purpose:    Constructor for an empty histogram.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+Histogram :: Histogram()
+{
+   for(unsigned int i = 0; i < BUCKETS; ++i)
+      buckets[i] = 0;
+
+   samples = total = 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       record
+
+Purpose:    Count a latency in its bucket.
+
+Parameters: value: latency in nanoseconds
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Histogram :: record(unsigned long long value)
+{
+   unsigned int bucket = value; /* bucket of small values */
+
+   /* highest set bit picks the power of 2, the bits after it the bucket */
+   if(value >= SUB_BUCKETS)
+   {
+      unsigned int highest = 63 - __builtin_clzll(value);
+      bucket = (highest - SUB_BITS + 1) * SUB_BUCKETS +
+               ((value >> (highest - SUB_BITS)) & (SUB_BUCKETS - 1));
+   }
+
+   ++buckets[bucket];
+   ++samples;
+   total += value;
+}
+
+/*------------------------------------------------------------------------------
+Name:       percentile
+
+Purpose:    Latency at or below which the given share of samples fall, given as
+            the largest value of the bucket holding that sample. The sample is
+            picked by nearest rank, the ceiling of share times samples, so p50
+            of 1 to 10 is 5 and p99 of 100 samples is the 99th.
+
+Parameters: share: share of samples between 0 and 1, 0.99 for p99
+
+Return:     latency in nanoseconds, 0 for an empty histogram
+------------------------------------------------------------------------------*/
+unsigned long long Histogram :: percentile(double share)
+{
+   unsigned long long wanted = 0; /* samples to count past */
+   unsigned long long counted = 0; /* samples counted so far */
+   double rank = std :: ceil(share * samples - 1e-9); /* nearest rank, the
+                      tiny offset keeps 0.07 * 100 from rounding up to 8 */
+
+   /* empty histogram has no latencies */
+   if(samples == 0)
+      return 0;
+
+   /* ranks count from 1, at least one and at most all samples are counted */
+   if(rank >= samples)
+      wanted = samples - 1;
+   else if(rank > 1)
+      wanted = (unsigned long long)rank - 1;
+
+   for(unsigned int i = 0; i < BUCKETS; ++i)
+   {
+      counted += buckets[i];
+
+      /* stopped in this bucket, give its largest value */
+      if(counted > wanted)
+      {
+         if(i < SUB_BUCKETS)
+            return i;
+
+         unsigned int highest = i / SUB_BUCKETS + SUB_BITS - 1;
+         unsigned long long low = (unsigned long long)(SUB_BUCKETS +
+                                  i % SUB_BUCKETS) << (highest - SUB_BITS);
+
+         return low + (1ULL << (highest - SUB_BITS)) - 1;
+      }
+   }
+
+   return 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       count
+
+Purpose:    Amount of latencies recorded.
+
+Parameters: none
+
+Return:     samples: latencies recorded
+------------------------------------------------------------------------------*/
+unsigned long long Histogram :: count()
+{
+   return samples;
+}
+
+/*------------------------------------------------------------------------------
+Name:       sum
+
+Purpose:    Sum of all latencies recorded, in nanoseconds.
+
+Parameters: none
+
+Return:     total: sum of latencies recorded
+------------------------------------------------------------------------------*/
+unsigned long long Histogram :: sum()
+{
+   return total;
+}
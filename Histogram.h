@@ -0,0 +1,57 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   Histogram.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the latency histogram used when replaying
+         operations against a tree. Recording a latency is a few shifts and an
+         increment, so timing every operation costs little next to the
+         operation itself.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        Histogram
+
+Purpose:     Log linear histogram of latencies in nanoseconds. Every power of 2
+             is split into SUB_BUCKETS equal buckets, so a percentile is within
+             about 6 percent of the true value at any scale.
+
+Data Fields: buckets: amount of latencies recorded in each bucket
+             samples: amount of latencies recorded
+             total:   sum of all latencies recorded
+
+Functions: Histogram:  constructor
+           record:     count a latency
+           percentile: latency below which a share of the samples fall
+           count:      amount of latencies recorded
+           sum:        sum of all latencies recorded
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class Histogram
+{
+   public:
+      static const unsigned int SUB_BITS = 4; /* bits splitting a power of 2 */
+      static const unsigned int SUB_BUCKETS = 1 << SUB_BITS; /* buckets in a 
+                                                                power of 2 */
+      static const unsigned int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+                                                 /* buckets for any 64 bit value
+                                                  */
+   private:
+      /* data fields */
+      unsigned long long buckets[BUCKETS]; /* latencies in each bucket */
+      unsigned long long samples,          /* latencies recorded */
+                         total;            /* sum of latencies recorded */
+
+   public:
+      /* functions */
+      Histogram(void); /* constructor for an empty histogram */
+      void record(unsigned long long); /* count a latency */
+      unsigned long long percentile(double); /* latency at a share of samples */
+      unsigned long long count(void); /* latencies recorded */
+      unsigned long long sum(void); /* sum of latencies recorded */
+};
+
+#endif
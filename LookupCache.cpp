@@ -0,0 +1,162 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   LookupCache.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains the functions of the lookup cache. Slots are
+         rounded up to a power of 2 and start empty. A lookup compares the tag
+         before touching the node, so a miss never reads the node it replaces.
+         Storing simply overwrites whatever the slot held.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "LookupCache.h"
+#include<string>
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       LookupCache
+
+Purpose:    Constructor for a lookup cache with at least the given amount of 
+            slots, all empty.
+
+Parameters: slots: amount of slots wanted, rounded up to a power of 2
+
+Return:     none
+------------------------------------------------------------------------------*/
+LookupCache<Data> :: LookupCache(unsigned int slots)
+{
+   unsigned long long size = 1; /* slots made */
+
+   /* round up to a power of 2 so a mask picks the slot */
+   while(size < slots)
+      size <<= 1;
+
+   tags = new unsigned long long[size];
+   nodes = new Node<Data> * [size];
+   mask = size - 1;
+   hits = misses = 0;
+
+   /* every slot starts empty */
+   for(unsigned long long i = 0; i < size; ++i)
+   {
+      tags[i] = 0;
+      nodes[i] = 0;
+   }
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       ~LookupCache
+
+Purpose:    Destructor freeing the slots, the nodes belong to the tree.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+LookupCache<Data> :: ~LookupCache()
+{
+   delete [] tags;
+   delete [] nodes;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       lookup
+
+Purpose:    Return the node holding the entry if its slot has it. The tag must
+            match the hash and the node must hold the entry.
+
+Parameters: hash:  hash of the entry
+            entry: entry looked up
+
+Return:     node holding the entry, null on a miss
+------------------------------------------------------------------------------*/
+Node<Data> * LookupCache<Data> :: lookup(unsigned long long hash,
+                                         const Data & entry)
+{
+   unsigned long long slot = hash & mask; /* slot of the hash */
+
+   if(nodes[slot] && tags[slot] == hash && nodes[slot]->entry == entry)
+   {
+      ++hits;
+      return nodes[slot];
+   }
+
+   ++misses;
+   return 0;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       store
+
+Purpose:    Cache the node holding an entry, replacing what the slot held.
+
+Parameters: hash: hash of the entry held by the node
+            node: node to cache
+
+Return:     void
+------------------------------------------------------------------------------*/
+void LookupCache<Data> :: store(unsigned long long hash, Node<Data> * node)
+{
+   tags[hash & mask] = hash;
+   nodes[hash & mask] = node;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       invalidate
+
+Purpose:    Empty the slot of a hash if it holds that hash. Called before the
+            node of that entry is deleted or given another entry.
+
+Parameters: hash: hash of the entry whose node is going away
+
+Return:     void
+------------------------------------------------------------------------------*/
+void LookupCache<Data> :: invalidate(unsigned long long hash)
+{
+   if(tags[hash & mask] == hash)
+      nodes[hash & mask] = 0;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       hit_count
+
+Purpose:    Lookups answered by the cache.
+
+Parameters: none
+
+Return:     hits: lookups answered by the cache
+------------------------------------------------------------------------------*/
+unsigned long long LookupCache<Data> :: hit_count()
+{
+   return hits;
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       miss_count
+
+Purpose:    Lookups the cache could not answer and left to the tree.
+
+Parameters: none
+
+Return:     misses: lookups left to the tree
+------------------------------------------------------------------------------*/
+unsigned long long LookupCache<Data> :: miss_count()
+{
+   return misses;
+}
+
+/* define all types for the template class */
+template class LookupCache<char>; /* cache of char nodes */
+template class LookupCache<short>; /* cache of short nodes */
+template class LookupCache<int>; /* cache of int nodes */
+template class LookupCache<float>; /* cache of float nodes */
+template class LookupCache<double>; /* cache of double nodes */
+template class LookupCache<long>; /* cache of long nodes */
+template class LookupCache<std :: string>; /* cache of string nodes */
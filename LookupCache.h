@@ -0,0 +1,62 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   LookupCache.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the lookup cache a tree can keep in front of
+         find. It maps the hash of a recently found entry straight to its node,
+         so entries found over and over skip walking down from the root.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+#include "Node.h"
+
+template<typename Data> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        LookupCache
+
+Purpose:     Direct mapped cache from the hash of an entry to the node holding
+             it. The low bits of a hash pick the slot, the full hash is kept as
+             a tag and the entry of the node is checked on every hit. Nodes
+             must be invalidated before they are deleted or given another entry,
+             rotations move nodes without either so they need nothing.
+
+Data Fields: tags:   hash stored in each slot
+             nodes:  node stored in each slot, null if empty
+             mask:   slots minus 1, slots being a power of 2
+             hits:   lookups answered by the cache
+             misses: lookups left to the tree
+
+Functions: LookupCache:  constructor
+           ~LookupCache: destructor
+           lookup:       node holding an entry if cached
+           store:        cache the node holding an entry
+           invalidate:   drop the slot of a hash
+           hit_count:    lookups answered by the cache
+           miss_count:   lookups left to the tree
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class LookupCache
+{
+   private:
+      /* data fields */
+      unsigned long long * tags; /* hash stored in each slot */
+      Node<Data> ** nodes;       /* node stored in each slot */
+      unsigned long long mask;   /* slots minus 1 */
+      unsigned long long hits,   /* lookups answered by the cache */
+                         misses; /* lookups left to the tree */
+
+   public:
+      /* functions */
+      LookupCache(unsigned int); /* constructor for an amount of slots */
+      ~LookupCache(void); /* destructor freeing the slots */
+      Node<Data> * lookup(unsigned long long, const Data &); /* cached node of
+                                                                an entry */
+      void store(unsigned long long, Node<Data> *); /* cache a node */
+      void invalidate(unsigned long long); /* drop the slot of a hash */
+      unsigned long long hit_count(void); /* lookups answered by the cache */
+      unsigned long long miss_count(void); /* lookups left to the tree */
+};
+
+#endif
@@ -8,7 +8,9 @@
 Purpose: This contains the definition of a node along with a destructor to allow
          deletion of this node. Node values are set to default. This implements
          finding the sucessor of the node that was passed in. This is also where
-         a function to print a node passed in is implemented.
+         a function to print a node passed in is implemented. Nodes of strings
+         cache a prefix of their entry so most comparisons while descending the
+         tree are one integer compare instead of a read of the string's buffer.
 =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
 #include "Node.h"
 #include<iostream>
@@ -25,12 +27,13 @@ Parameters: entry: value held by this node via generic
 
 Return:     none
 ------------------------------------------------------------------------------*/
-Node<Data> :: Node(Data entry)
+Node<Data> :: Node(Data entry) : KeyPrefix<Data>(entry)
 {
    parent = right = left = 0; /* pointers are null by default */
-   height = level = 0; /* height and level are empty */
+   height = 0; /* height is empty */
    width = depth = 1; /* depth if 1 when this node exists */
    balance = 0; /* node starts at perfect balance */
+   count = 1; /* node is made for its first occurrence */
    this->entry = entry; /* data value held by this node via generic */
 }
 
@@ -49,6 +52,85 @@ Node<Data> :: ~Node()
    /* no defined implementation for the destructor */  
 }
 
+/*------------------------------------------------------------------------------
+Name:       KeyPrefix
+
+Purpose:    Constructor for the prefix of a string entry.
+
+Parameters: entry: string to pack the prefix of
+
+Return:     none
+------------------------------------------------------------------------------*/
+KeyPrefix<std :: string> :: KeyPrefix(const std :: string & entry)
+{
+   set_prefix(entry);
+}
+
+/*------------------------------------------------------------------------------
+Name:       set_prefix
+
+Purpose:    Pack the first 8 bytes of the string big endian, the first byte 
+            being the most significant. Shorter strings are padded with zeros.
+
+Parameters: entry: string to pack the prefix of
+
+Return:     void
+------------------------------------------------------------------------------*/
+void KeyPrefix<std :: string> :: set_prefix(const std :: string & entry)
+{
+   prefix = 0;
+
+   for(std :: string :: size_type i = 0; i < 8; ++i)
+   {
+      prefix <<= 8;
+      if(i < entry.size())
+         prefix |= (unsigned char)entry[i];
+   }
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       compare
+
+Purpose:    Order the entry of this node against the given entry.
+
+Parameters: entry:  entry to compare against
+            prefix: prefix of that entry, unused by types without a prefix
+
+Return:     negative if this node's entry is smaller, positive if it is bigger,
+            0 if they are equal
+------------------------------------------------------------------------------*/
+int Node<Data> :: compare(const Data & entry, const KeyPrefix<Data> &)
+{
+   if(this->entry == entry)
+      return 0;
+
+   return this->entry < entry ? -1 : 1;
+}
+
+/*------------------------------------------------------------------------------
+Name:       compare
+
+Purpose:    Order the entry of this node against the given string. Differing
+            prefixes settle it without reading either string, only a tie reads
+            the strings themselves.
+
+Parameters: entry: string to compare against
+            key:   prefix of that string
+
+Return:     negative if this node's entry is smaller, positive if it is bigger,
+            0 if they are equal
+------------------------------------------------------------------------------*/
+template<>
+int Node<std :: string> :: compare(const std :: string & entry,
+                                   const KeyPrefix<std :: string> & key)
+{
+   if(prefix != key.prefix)
+      return prefix < key.prefix ? -1 : 1;
+
+   return this->entry.compare(entry);
+}
+
 template<typename Data> /* define template definition for function below */
 /*------------------------------------------------------------------------------
 Name:       sucessor
@@ -113,7 +195,8 @@ template<typename Data> /* define template definition for function below */
 /*------------------------------------------------------------------------------
 Name:       print_node
 
-Purpose:    print the contents of the node passed in
+Purpose:    print the contents of the node passed in. Rotations move nodes
+            between levels so the level is counted from the parents.
 
 Parameters: node: node to have its values printed
 
@@ -121,13 +204,19 @@ Return:     void
 ------------------------------------------------------------------------------*/
 void Node<Data> :: print_node(Node<Data> * node)
 {
+   unsigned int level = 0; /* steps from the root to the node */
+
+   for(Node<Data> * above = node->parent; above; above = above->parent)
+      ++level;
+
    /* print data fields of the node */
    std :: cout << node->entry << " ::"
                << " height: " << node->height << " ::"
                << " width: " << node->width << " ::"
-               << " level: " << node->level << " ::"
+               << " level: " << level << " ::"
                << " depth: " << node->depth << " ::"
-               << " balance: " << node->balance << " ::";
+               << " balance: " << node->balance << " ::"
+               << " count: " << node->count << " ::";
 
    /* print pointers from this node */
    if(node->parent) 
@@ -141,9 +230,9 @@ void Node<Data> :: print_node(Node<Data> * node)
       std :: cout << " right: " << "NULL " << "::"; /* no right */
 
    if(node->left)
-      std :: cout << " left: " << node->left->entry << std :: endl; /* left */
+      std :: cout << " left: " << node->left->entry << '\n'; /* left */
    else
-      std :: cout << " left: " << "NULL" << std :: endl; /* no left */
+      std :: cout << " left: " << "NULL" << '\n'; /* no left */
 }
 
 /* define all types for the template class */
@@ -10,6 +10,50 @@ Purpose: This is the definition of the node class. All members are public
 =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
 #ifndef NODE_H
 #define NODE_H
+#include<string>
+
+template<typename Data> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        KeyPrefix
+
+Purpose:     Cached prefix of an entry used to settle comparisons without
+             reading the entry itself. Only strings keep one, for every other
+             type this is empty and takes no space in a node.
+
+Functions: KeyPrefix:  constructor
+           set_prefix: make the prefix of a new entry
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class KeyPrefix
+{
+   public:
+      /* functions */
+      KeyPrefix(const Data &) {} /* nothing to cache */
+      void set_prefix(const Data &) {} /* nothing to cache */
+};
+
+template<> /* define string specialization for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        KeyPrefix
+
+Purpose:     First 8 bytes of a string packed big endian into an integer and
+             padded with zeros, so comparing two prefixes orders strings the 
+             same way comparing the strings does unless the prefixes tie.
+
+Data Fields: prefix: packed first 8 bytes of the entry
+
+Functions: KeyPrefix:  constructor
+           set_prefix: pack the prefix of a new entry
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class KeyPrefix<std :: string>
+{
+   public:
+      /* data fields */
+      unsigned long long prefix; /* packed first 8 bytes of the entry */
+
+      /* functions */
+      KeyPrefix(const std :: string &); /* constructor packing the prefix */
+      void set_prefix(const std :: string &); /* pack the prefix of an entry */
+};
 
 template<typename Data> /* define template definition for class below */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -23,17 +67,20 @@ Data Fields: parent:  top node
              left:    left node
              entry:   value in node
              height:  how tall is the node
-             level:   level of node's address
              width:   width of subtree defined by node
              depth:   depth of node
              balance: right height minus left height of the node
+             count:   occurrences of entry, above 1 only in a multiset
+             prefix:  cached prefix of entry inherited from KeyPrefix, strings
+                      only
 
 Functions: Node:       constructor
            ~Node:      destructor
+           compare:    order of entry against another entry
            sucessor:   find next node
            print_node: print contents of node
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-class Node
+class Node : public KeyPrefix<Data>
 {
    public:
       /* data fields */
@@ -42,16 +89,17 @@ class Node
       Node<Data> * left;   /* left pointer */
       Data entry;          /* entry held via generic */
       unsigned int height, /* height of the node */
-                   level,  /* current level where this node resides in the tree
-                              */
                    width,  /* how wide the subtree defined by this node is */
                    depth;  /* depth of this node */
       int balance;         /* balance of this node defined by left and right 
                               heights */
+      unsigned int count;  /* occurrences of entry held by this node */
   
       /* functions */
       Node(Data); /* constructor for defining a node object of a given entry */
       ~Node(void); /* destructor implementing node deletion */
+      int compare(const Data &, const KeyPrefix<Data> &); /* order of entry 
+                                                             against another */
       Node<Data> * sucessor(Node<Data> *); /* find next node in ascending order 
                                               of entry of the node passed in */
       void print_node(Node<Data> *); /* print the contents of this node */
@@ -0,0 +1,929 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   SharedTree.cpp
+--------------------------------------------------------------------------------
+Purpose: This file contains all the functions of the shared tree. The segment
+         starts with the header, rounded up to a cache line, followed by a
+         fixed amount of node slots. Freed slots are chained through their left
+         offset and used again before any slot never used. Inserting and
+         removing balance the tree as a strict avl tree the same way the tree
+         class does, by retracing from the lowest changed node. Every change is
+         wrapped in two bumps of the sequence so readers can tell a read raced
+         with it. Readers check every offset they follow before using it and
+         bound every walk by the amount of slots, so a torn read is retried
+         instead of going astray. A read waiting on a change gives up once the
+         writer process is gone or the change outlasts SHARED_READ_WAIT.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#include "SharedTree.h"
+#include<cstring>
+#include<cerrno>
+#include<new>
+#include<chrono>
+#include<string_view>
+#include<sched.h>
+#include<signal.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "sequence must work across "
+                                           "processes");
+
+static const unsigned long long MAGIC = 0x5348415245445452ULL; /* "SHAREDTR" */
+static const unsigned long long NODES = (sizeof(SharedHeader) + 63) / 64 * 64;
+                                        /* offset of the first node slot */
+
+/*------------------------------------------------------------------------------
+Name:       SharedTree
+
+Purpose:    Constructor for a handle with no segment mapped yet.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+SharedTree :: SharedTree()
+{
+   base = 0; /* nothing mapped */
+   bytes = 0;
+   writer = false;
+   stuck = false;
+}
+
+/*------------------------------------------------------------------------------
+Name:       ~SharedTree
+
+Purpose:    Destructor, unmaps the segment. The segment itself stays until
+            destroy is called.
+
+Parameters: none
+
+Return:     none
+------------------------------------------------------------------------------*/
+SharedTree :: ~SharedTree()
+{
+   close();
+}
+
+/*------------------------------------------------------------------------------
+Name:       create
+
+Purpose:    Make a new shared memory segment of the given name with room for an
+            amount of nodes and map it as its writer. Fails if a segment of that
+            name exists already.
+
+Parameters: name:     name of the segment, starting with /
+            capacity: amount of nodes the segment holds
+
+Return:     created: whether the segment was made and mapped
+------------------------------------------------------------------------------*/
+bool SharedTree :: create(const char * name, unsigned int capacity)
+{
+   unsigned long long size = NODES +
+                             (unsigned long long)capacity * sizeof(SharedNode);
+   int fd; /* descriptor of the segment */
+
+   close();
+
+   fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+   if(fd < 0)
+      return false;
+
+   /* size the segment, then map it */
+   if(ftruncate(fd, size) != 0)
+   {
+      ::close(fd);
+      shm_unlink(name);
+      return false;
+   }
+
+   void * mapped = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   ::close(fd); /* the mapping keeps the segment */
+
+   if(mapped == MAP_FAILED)
+   {
+      shm_unlink(name);
+      return false;
+   }
+
+   base = static_cast<char *>(mapped);
+   bytes = size;
+   writer = true;
+
+   /* empty tree, magic goes last so readers never see half a header */
+   SharedHeader * top = new(base) SharedHeader;
+   top->capacity = capacity;
+   top->sequence.store(0, std :: memory_order_relaxed);
+   top->writer = getpid();
+   top->root = top->occupancy = 0;
+   top->free_list = 0;
+   top->unused = NODES;
+   std :: atomic_thread_fence(std :: memory_order_release);
+   top->magic = MAGIC;
+
+   return true;
+}
+
+/*------------------------------------------------------------------------------
+Name:       open
+
+Purpose:    Map an existing segment read only as a reader.
+
+Parameters: name: name of the segment, starting with /
+
+Return:     opened: whether the segment exists and holds a shared tree
+------------------------------------------------------------------------------*/
+bool SharedTree :: open(const char * name)
+{
+   struct stat status; /* size of the segment */
+   int fd; /* descriptor of the segment */
+
+   close();
+
+   fd = shm_open(name, O_RDONLY, 0);
+   if(fd < 0)
+      return false;
+
+   if(fstat(fd, &status) != 0 ||
+      (unsigned long long)status.st_size < NODES)
+   {
+      ::close(fd);
+      return false;
+   }
+
+   void * mapped = mmap(0, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   ::close(fd); /* the mapping keeps the segment */
+
+   if(mapped == MAP_FAILED)
+      return false;
+
+   base = static_cast<char *>(mapped);
+   bytes = status.st_size;
+   writer = false;
+
+   /* not a shared tree, or not done being created */
+   if(header()->magic != MAGIC)
+   {
+      close();
+      return false;
+   }
+
+   std :: atomic_thread_fence(std :: memory_order_acquire);
+   return true;
+}
+
+/*------------------------------------------------------------------------------
+Name:       close
+
+Purpose:    Unmap the segment if one is mapped.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: close()
+{
+   if(base)
+      munmap(base, bytes);
+
+   base = 0;
+   bytes = 0;
+   writer = false;
+   stuck = false;
+}
+
+/*------------------------------------------------------------------------------
+Name:       destroy
+
+Purpose:    Remove a segment by name. Processes that have it mapped keep using
+            it until they close it.
+
+Parameters: name: name of the segment, starting with /
+
+Return:     whether the segment was removed
+------------------------------------------------------------------------------*/
+bool SharedTree :: destroy(const char * name)
+{
+   return shm_unlink(name) == 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       header
+
+Purpose:    Header at the start of the segment.
+
+Parameters: none
+
+Return:     header of the tree
+------------------------------------------------------------------------------*/
+SharedHeader * SharedTree :: header()
+{
+   return reinterpret_cast<SharedHeader *>(base);
+}
+
+/*------------------------------------------------------------------------------
+Name:       at
+
+Purpose:    Node at an offset from the start of the segment.
+
+Parameters: offset: offset of the node, must be valid
+
+Return:     node at the offset
+------------------------------------------------------------------------------*/
+SharedNode * SharedTree :: at(unsigned long long offset)
+{
+   return reinterpret_cast<SharedNode *>(base + offset);
+}
+
+/*------------------------------------------------------------------------------
+Name:       valid
+
+Purpose:    Whether an offset is the start of a node slot in this segment. A
+            reader racing the writer may load any value, this keeps it in
+            bounds.
+
+Parameters: offset: offset to check
+
+Return:     whether the offset can be used with at
+------------------------------------------------------------------------------*/
+bool SharedTree :: valid(unsigned long long offset)
+{
+   return offset >= NODES && offset + sizeof(SharedNode) <= bytes &&
+          (offset - NODES) % sizeof(SharedNode) == 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       load_entry
+
+Purpose:    Copy the entry of a node out of the segment word by word. A torn
+            length is cut down to SHARED_KEY_MAX so the copy stays in bounds.
+
+Parameters: node:   offset of the node
+            buffer: SHARED_KEY_MAX bytes to copy the entry to
+
+Return:     length: length of the entry, 0 for an invalid offset
+------------------------------------------------------------------------------*/
+unsigned int SharedTree :: load_entry(unsigned long long node, char * buffer)
+{
+   if(!valid(node))
+      return 0;
+
+   SharedNode * shared = at(node);
+   unsigned int length = shared->length; /* read once, may be torn */
+
+   if(length > SHARED_KEY_MAX)
+      length = SHARED_KEY_MAX;
+
+   /* whole words, the last one may run past the entry */
+   for(unsigned int i = 0; i * 8 < length; ++i)
+   {
+      unsigned long long word = shared->entry[i]; /* 8 bytes of the entry */
+      std :: memcpy(buffer + i * 8, &word, 8);
+   }
+
+   return length;
+}
+
+/*------------------------------------------------------------------------------
+Name:       store_entry
+
+Purpose:    Copy an entry into a node word by word, the last word padded with
+            zeros.
+
+Parameters: node:   offset of the node
+            text:   bytes of the entry
+            length: length of the entry, at most SHARED_KEY_MAX
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: store_entry(unsigned long long node, const char * text,
+                               unsigned int length)
+{
+   SharedNode * shared = at(node);
+
+   for(unsigned int i = 0; i * 8 < length; ++i)
+   {
+      unsigned long long word = 0; /* 8 bytes of the entry */
+      std :: memcpy(&word, text + i * 8, length - i * 8 < 8 ? length - i * 8
+                                                            : 8);
+      shared->entry[i] = word;
+   }
+
+   shared->length = length;
+}
+
+/*------------------------------------------------------------------------------
+Name:       compare
+
+Purpose:    Order the entry of a node against the given entry.
+
+Parameters: node:  offset of the node
+            entry: entry to compare against
+
+Return:     negative if the node's entry is smaller, positive if it is bigger,
+            0 if they are equal
+------------------------------------------------------------------------------*/
+int SharedTree :: compare(unsigned long long node, const std :: string & entry)
+{
+   char buffer[SHARED_KEY_MAX]; /* copy of the node's entry */
+   unsigned int length = load_entry(node, buffer);
+
+   return std :: string_view(buffer, length).compare(entry);
+}
+
+/*------------------------------------------------------------------------------
+Name:       height
+
+Purpose:    Height of a node, a missing node counting as -1.
+
+Parameters: offset: offset of the node, 0 for none
+
+Return:     height of the node
+------------------------------------------------------------------------------*/
+int SharedTree :: height(unsigned long long offset)
+{
+   return offset ? at(offset)->height : -1;
+}
+
+/*------------------------------------------------------------------------------
+Name:       update
+
+Purpose:    Recompute the height of a node from its children.
+
+Parameters: offset: offset of the node
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: update(unsigned long long offset)
+{
+   SharedNode * node = at(offset);
+   int right_height = height(node->right);
+   int left_height = height(node->left);
+
+   node->height = (right_height > left_height ? right_height : left_height) + 1;
+}
+
+/*------------------------------------------------------------------------------
+Name:       replace
+
+Purpose:    Point the parent of a node, or the root, at another node instead.
+            The parent offset of the other node is left to the caller.
+
+Parameters: old_node: offset of the node being replaced
+            new_node: offset of the node taking its place, 0 for none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: replace(unsigned long long old_node,
+                           unsigned long long new_node)
+{
+   unsigned long long parent = at(old_node)->parent;
+
+   if(!parent)
+      header()->root = new_node;
+   else if(at(parent)->left == old_node)
+      at(parent)->left = new_node;
+   else
+      at(parent)->right = new_node;
+}
+
+/*------------------------------------------------------------------------------
+Name:       rotate_left
+
+Purpose:    Single rotation moving the right child of the node up into its
+            place.
+
+Parameters: offset: offset of the node to be rotated down
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: rotate_left(unsigned long long offset)
+{
+   SharedNode * node = at(offset);
+   unsigned long long pivot = node->right; /* node moving up */
+
+   /* left subtree of the pivot moves under the node */
+   node->right = at(pivot)->left;
+   if(node->right)
+      at(node->right)->parent = offset;
+
+   /* pivot takes the place of the node, node goes under the pivot */
+   replace(offset, pivot);
+   at(pivot)->parent = node->parent;
+   at(pivot)->left = offset;
+   node->parent = pivot;
+
+   update(offset);
+   update(pivot);
+}
+
+/*------------------------------------------------------------------------------
+Name:       rotate_right
+
+Purpose:    Single rotation moving the left child of the node up into its
+            place.
+
+Parameters: offset: offset of the node to be rotated down
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: rotate_right(unsigned long long offset)
+{
+   SharedNode * node = at(offset);
+   unsigned long long pivot = node->left; /* node moving up */
+
+   /* right subtree of the pivot moves under the node */
+   node->left = at(pivot)->right;
+   if(node->left)
+      at(node->left)->parent = offset;
+
+   /* pivot takes the place of the node, node goes under the pivot */
+   replace(offset, pivot);
+   at(pivot)->parent = node->parent;
+   at(pivot)->right = offset;
+   node->parent = pivot;
+
+   update(offset);
+   update(pivot);
+}
+
+/*------------------------------------------------------------------------------
+Name:       retrace
+
+Purpose:    Walk up from the lowest node changed by an insert or remove,
+            updating heights and rotating any node whose balance is past 1
+            either way. Stops once a subtree keeps its old height.
+
+Parameters: offset: offset of the lowest node whose children changed, 0 for
+                    none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void SharedTree :: retrace(unsigned long long offset)
+{
+   while(offset)
+   {
+      int old_height = at(offset)->height; /* height before the change */
+      SharedNode * node = at(offset);
+
+      update(offset);
+
+      int balance = height(node->right) - height(node->left);
+
+      /* right side too tall, double rotate if the right child leans left */
+      if(balance > 1)
+      {
+         SharedNode * right = at(node->right);
+         if(height(right->right) < height(right->left))
+            rotate_right(node->right);
+
+         rotate_left(offset);
+         offset = node->parent;
+      }
+      /* left side too tall, double rotate if the left child leans right */
+      else if(balance < -1)
+      {
+         SharedNode * left = at(node->left);
+         if(height(left->left) < height(left->right))
+            rotate_left(node->left);
+
+         rotate_right(offset);
+         offset = node->parent;
+      }
+
+      /* subtree kept its height, nodes above are unaffected */
+      if(at(offset)->height == old_height)
+         break;
+
+      offset = at(offset)->parent;
+   }
+}
+
+/*------------------------------------------------------------------------------
+Name:       insert
+
+Purpose:    Add a node holding the entry. Only the writer may insert. Fails for
+            duplicates, for entries longer than SHARED_KEY_MAX and when every
+            node slot is in use, telling which.
+
+Parameters: entry: entry to be held by the new node
+
+Return:     outcome of the insertion, SHARED_INSERTED on sucess
+------------------------------------------------------------------------------*/
+SharedInsert SharedTree :: insert(const std :: string & entry)
+{
+   if(!writer)
+      return SHARED_READ_ONLY;
+   if(entry.size() > SHARED_KEY_MAX)
+      return SHARED_TOO_LONG;
+
+   SharedHeader * top = header();
+   unsigned long long current = top->root; /* node being passed */
+   unsigned long long parent = 0; /* node the new node goes under */
+   int order = 0; /* parent's entry compared to the entry */
+
+   /* find the null spot for the entry, only the writer changes the tree so
+      no read check is needed */
+   while(current)
+   {
+      order = compare(current, entry);
+
+      /* duplicate insert is not allowed */
+      if(order == 0)
+         return SHARED_DUPLICATE;
+
+      parent = current;
+      current = order < 0 ? at(current)->right : at(current)->left;
+   }
+
+   /* every slot in use */
+   if(!top->free_list && top->unused + sizeof(SharedNode) > bytes)
+      return SHARED_FULL;
+
+   /* readers retry from here until the change is done */
+   unsigned long long sequence =
+      top->sequence.load(std :: memory_order_relaxed);
+   top->sequence.store(sequence + 1, std :: memory_order_relaxed);
+   std :: atomic_thread_fence(std :: memory_order_release);
+
+   /* take a freed slot first, then one never used */
+   if(top->free_list)
+   {
+      current = top->free_list;
+      top->free_list = at(current)->left;
+   }
+   else
+   {
+      current = top->unused;
+      top->unused += sizeof(SharedNode);
+      new(at(current)) SharedNode;
+   }
+
+   /* fill the node and hang it under its parent */
+   SharedNode * node = at(current);
+   node->parent = parent;
+   node->left = node->right = 0;
+   node->height = 0;
+   store_entry(current, entry.data(), entry.size());
+
+   if(!parent)
+      top->root = current;
+   else if(order < 0)
+      at(parent)->right = current;
+   else
+      at(parent)->left = current;
+
+   top->occupancy = top->occupancy + 1;
+   retrace(parent);
+
+   top->sequence.store(sequence + 2, std :: memory_order_release);
+   return SHARED_INSERTED;
+}
+
+/*------------------------------------------------------------------------------
+Name:       remove
+
+Purpose:    Remove the node holding the entry. Only the writer may remove. A
+            node with two children takes the entry of its predecessor and the
+            predecessor's node is removed instead. The slot is freed for reuse.
+
+Parameters: entry: entry of the node looking for removal
+
+Return:     removed: status of whether a node was removed
+------------------------------------------------------------------------------*/
+bool SharedTree :: remove(const std :: string & entry)
+{
+   if(!writer)
+      return false;
+
+   SharedHeader * top = header();
+   unsigned long long current = top->root; /* node being passed */
+
+   /* search for the node holding the entry */
+   while(current)
+   {
+      int order = compare(current, entry);
+
+      if(order == 0)
+         break;
+
+      current = order < 0 ? at(current)->right : at(current)->left;
+   }
+
+   /* entry not in the tree */
+   if(!current)
+      return false;
+
+   /* readers retry from here until the change is done */
+   unsigned long long sequence =
+      top->sequence.load(std :: memory_order_relaxed);
+   top->sequence.store(sequence + 1, std :: memory_order_relaxed);
+   std :: atomic_thread_fence(std :: memory_order_release);
+
+   /* two children, move the predecessor's entry here and remove it instead */
+   if(at(current)->left && at(current)->right)
+   {
+      unsigned long long original = current; /* node keeping its place */
+      char buffer[SHARED_KEY_MAX]; /* entry of the predecessor */
+      current = at(original)->left;
+
+      while(at(current)->right)
+         current = at(current)->right;
+
+      store_entry(original, buffer, load_entry(current, buffer));
+   }
+
+   /* current has at most one child which takes its place */
+   SharedNode * node = at(current);
+   unsigned long long child = node->left ? node->left : node->right;
+   unsigned long long parent = node->parent;
+
+   if(child)
+      at(child)->parent = parent;
+   replace(current, child);
+
+   /* slot goes on the free list */
+   node->parent = node->right = 0;
+   node->left = top->free_list;
+   top->free_list = current;
+
+   top->occupancy = top->occupancy - 1;
+   retrace(parent);
+
+   top->sequence.store(sequence + 2, std :: memory_order_release);
+   return true;
+}
+
+/*------------------------------------------------------------------------------
+Name:       stalled
+
+Purpose:    Whether the last read gave up waiting on the writer, because the
+            writer process is gone or a change lasted past SHARED_READ_WAIT.
+            A writer that died mid change leaves the tree unreadable.
+
+Parameters: none
+
+Return:     whether the last read gave up
+------------------------------------------------------------------------------*/
+bool SharedTree :: stalled()
+{
+   return stuck;
+}
+
+/*------------------------------------------------------------------------------
+Name:       read_begin
+
+Purpose:    Start a read of the tree, waiting out any change in progress. Pass
+            the sequence to read_retry once done reading. The wait for one
+            change is bounded by SHARED_READ_WAIT and ends at once if the
+            writer process no longer exists.
+
+Parameters: sequence: set to the sequence the read started at
+
+Return:     started: false if the read gave up on the writer
+------------------------------------------------------------------------------*/
+bool SharedTree :: read_begin(unsigned long long & sequence)
+{
+   SharedHeader * top = header();
+   unsigned long long waited_on = 0; /* odd sequence being waited out */
+   std :: chrono :: steady_clock :: time_point start; /* when that began */
+
+   stuck = false;
+
+   /* odd means the writer is in the middle of a change */
+   while((sequence = top->sequence.load(std :: memory_order_acquire)) & 1)
+   {
+      /* a new change, time it from now */
+      if(sequence != waited_on)
+      {
+         waited_on = sequence;
+         start = std :: chrono :: steady_clock :: now();
+      }
+      /* writer is gone or the change is taking too long */
+      else if((kill(top->writer, 0) != 0 && errno == ESRCH) ||
+              std :: chrono :: steady_clock :: now() - start >
+              std :: chrono :: milliseconds(SHARED_READ_WAIT))
+      {
+         stuck = true;
+         return false;
+      }
+
+      sched_yield();
+   }
+
+   return true;
+}
+
+/*------------------------------------------------------------------------------
+Name:       read_retry
+
+Purpose:    Whether the tree changed since read_begin, in which case anything
+            read must be thrown away and read again.
+
+Parameters: sequence: value returned by read_begin
+
+Return:     whether the read must be repeated
+------------------------------------------------------------------------------*/
+bool SharedTree :: read_retry(unsigned long long sequence)
+{
+   std :: atomic_thread_fence(std :: memory_order_acquire);
+   return header()->sequence.load(std :: memory_order_relaxed) != sequence;
+}
+
+/*------------------------------------------------------------------------------
+Name:       find
+
+Purpose:    search for a node in this tree to see whether or not it exists,
+            repeating the search if the writer changed the tree meanwhile
+
+Parameters: entry: entry to be searched for
+
+Return:     found: status of whether a node holds the entry, false as well if
+                   the read gave up on the writer
+------------------------------------------------------------------------------*/
+bool SharedTree :: find(const std :: string & entry)
+{
+   unsigned long long slots = (bytes - NODES) / sizeof(SharedNode);
+   bool found = false; /* status of the search */
+
+   /* nothing mapped */
+   if(!base)
+      return found;
+
+   while(true)
+   {
+      unsigned long long sequence; /* sequence the read started at */
+
+      if(!read_begin(sequence))
+         return false;
+
+      unsigned long long current = header()->root; /* node being passed */
+      unsigned long long steps = 0; /* nodes passed */
+      bool torn = false; /* followed an offset that is not a node */
+
+      found = false;
+
+      /* go left or right until the entry is found or a null child is hit */
+      while(current)
+      {
+         if(!valid(current) || ++steps > slots)
+         {
+            torn = true;
+            break;
+         }
+
+         int order = compare(current, entry);
+
+         if(order == 0)
+         {
+            found = true;
+            break;
+         }
+
+         current = order < 0 ? at(current)->right : at(current)->left;
+      }
+
+      /* a consistent read, a torn one without a change is a broken segment */
+      if(!read_retry(sequence))
+         return found && !torn;
+   }
+}
+
+/*------------------------------------------------------------------------------
+Name:       entries
+
+Purpose:    Copy every entry in ascending order, repeating the walk if the
+            writer changed the tree meanwhile.
+
+Parameters: list: filled with the entries
+
+Return:     whether a segment is mapped and the read did not give up on the
+            writer
+------------------------------------------------------------------------------*/
+bool SharedTree :: entries(std :: vector<std :: string> & list)
+{
+   unsigned long long slots = (bytes - NODES) / sizeof(SharedNode);
+
+   /* nothing mapped */
+   if(!base)
+      return false;
+
+   do
+   {
+      unsigned long long sequence; /* sequence the read started at */
+      unsigned long long steps = 0; /* nodes passed */
+
+      list.clear();
+
+      if(!read_begin(sequence))
+         return false;
+
+      for(unsigned long long node = first_node(); node && steps++ < slots;
+          node = sucessor(node))
+         list.push_back(entry(node));
+
+      if(!read_retry(sequence))
+         return true;
+   }
+   while(true);
+}
+
+/*------------------------------------------------------------------------------
+Name:       first_node
+
+Purpose:    Offset of the node of smallest entry. Call between read_begin and
+            read_retry.
+
+Parameters: none
+
+Return:     offset of the first node, 0 if the tree is empty
+------------------------------------------------------------------------------*/
+unsigned long long SharedTree :: first_node()
+{
+   unsigned long long slots = (bytes - NODES) / sizeof(SharedNode);
+   unsigned long long node = base ? header()->root : 0;
+
+   /* go as left as possible */
+   for(unsigned long long steps = 0; valid(node) && at(node)->left &&
+       steps < slots; ++steps)
+      node = at(node)->left;
+
+   return valid(node) ? node : 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       sucessor
+
+Purpose:    Offset of the next node in ascending order of entry. With a right
+            child it is the leftmost node below it, otherwise the first parent
+            reached from its left. Call between read_begin and read_retry.
+
+Parameters: node: offset of the node to find the sucessor of
+
+Return:     offset of the sucessor, 0 if there is none
+------------------------------------------------------------------------------*/
+unsigned long long SharedTree :: sucessor(unsigned long long node)
+{
+   unsigned long long slots = (bytes - NODES) / sizeof(SharedNode);
+   unsigned long long steps = 0; /* nodes passed */
+
+   if(!valid(node))
+      return 0;
+
+   /* has a right child, go as left as possible below it */
+   if(at(node)->right)
+   {
+      node = at(node)->right;
+
+      while(valid(node) && at(node)->left && ++steps < slots)
+         node = at(node)->left;
+
+      return valid(node) ? node : 0;
+   }
+
+   /* keep going up while coming from the right */
+   while(valid(at(node)->parent) && at(at(node)->parent)->right == node &&
+         ++steps < slots)
+      node = at(node)->parent;
+
+   return valid(at(node)->parent) ? at(node)->parent : 0;
+}
+
+/*------------------------------------------------------------------------------
+Name:       entry
+
+Purpose:    Copy of the entry of a node. Only to be trusted if read_retry says
+            the tree did not change meanwhile.
+
+Parameters: node: offset of the node
+
+Return:     entry of the node, empty for an invalid offset
+------------------------------------------------------------------------------*/
+std :: string SharedTree :: entry(unsigned long long node)
+{
+   char buffer[SHARED_KEY_MAX]; /* copy of the entry */
+   unsigned int length = load_entry(node, buffer);
+
+   return std :: string(buffer, length);
+}
+
+/*------------------------------------------------------------------------------
+Name:       size
+
+Purpose:    Nodes in tree.
+
+Parameters: none
+
+Return:     occupancy of the tree, 0 if nothing is mapped
+------------------------------------------------------------------------------*/
+unsigned long long SharedTree :: size()
+{
+   if(!base)
+      return 0;
+
+   return header()->occupancy;
+}
@@ -0,0 +1,215 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   SharedTree.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the shared tree, an avl tree of strings
+         whose nodes live in a POSIX shared memory segment. Nodes link to each
+         other by their offset from the start of the segment instead of by
+         pointer, so the segment works wherever each process maps it. One
+         writer process creates the segment and inserts and removes entries,
+         any amount of local reader processes open it read only and run find
+         and iteration against it without a copy of their own. Every field a
+         reader looks at is a relaxed atomic, the sequence in the header orders
+         them, so a read racing the writer is torn but never undefined.
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef SHAREDTREE_H
+#define SHAREDTREE_H
+#include<atomic>
+#include<string>
+#include<vector>
+
+static const unsigned int SHARED_KEY_MAX = 96; /* longest entry a node holds */
+static const unsigned int SHARED_READ_WAIT = 1000; /* milliseconds a read waits
+                                                      out one change */
+
+/* outcomes of an insert */
+enum SharedInsert
+{
+   SHARED_INSERTED,  /* entry was added */
+   SHARED_DUPLICATE, /* entry was in the tree already */
+   SHARED_TOO_LONG,  /* entry is longer than SHARED_KEY_MAX */
+   SHARED_FULL,      /* every node slot is in use */
+   SHARED_READ_ONLY  /* handle is not the writer */
+};
+
+template<typename Value> /* define template definition for class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        Relaxed
+
+Purpose:     Value in the segment that is loaded and stored as a relaxed atomic
+             but used like a plain value. The writer changes these while
+             readers load them, the sequence makes the ordering.
+
+Data Fields: value: the atomic value
+
+Functions: Value: load the value
+           =:     store a value
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class Relaxed
+{
+   static_assert(std :: atomic<Value> :: is_always_lock_free,
+                 "fields must work across processes");
+
+   private:
+      /* data fields */
+      std :: atomic<Value> value; /* the atomic value */
+
+   public:
+      /* functions */
+      operator Value(void) const /* load the value */
+      {
+         return value.load(std :: memory_order_relaxed);
+      }
+
+      Relaxed & operator=(Value other) /* store a value */
+      {
+         value.store(other, std :: memory_order_relaxed);
+         return *this;
+      }
+
+      Relaxed & operator=(const Relaxed & other) /* store another's value */
+      {
+         return *this = (Value)other;
+      }
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        SharedNode
+
+Purpose:     Node of the shared tree. Links are offsets from the start of the
+             segment, 0 standing for null since the header is there. The entry
+             is kept in words so it is copied with word sized atomic loads.
+
+Data Fields: parent: offset of top node
+             right:  offset of right node
+             left:   offset of left node, next free node once freed
+             height: how tall the node is
+             length: length of the entry
+             entry:  bytes of the entry packed into words, not null terminated
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct SharedNode
+{
+   static const unsigned int WORDS = SHARED_KEY_MAX / 8; /* words of entry */
+
+   Relaxed<unsigned long long> parent, /* offset of parent node */
+                               right,  /* offset of right node */
+                               left;   /* offset of left node */
+   Relaxed<int> height;                /* how tall the node is */
+   Relaxed<unsigned int> length;       /* length of the entry */
+   Relaxed<unsigned long long> entry[WORDS]; /* bytes of the entry */
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        SharedHeader
+
+Purpose:     Start of the segment describing the tree in it. The sequence is
+             odd while the writer is changing the tree, readers that see it
+             change during a read try again.
+
+Data Fields: magic:     marks a segment made by a shared tree
+             capacity:  amount of node slots in the segment
+             sequence:  changes count, odd during a change
+             writer:    process id of the writer
+             root:      offset of the top node
+             free_list: offset of the first freed node
+             unused:    offset of the first node never used
+             occupancy: nodes in tree
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+struct SharedHeader
+{
+   Relaxed<unsigned long long> magic; /* marks a shared tree segment */
+   unsigned long long capacity;   /* node slots in the segment */
+   std :: atomic<unsigned long long> sequence; /* odd during a change */
+   Relaxed<int> writer;           /* process id of the writer */
+   Relaxed<unsigned long long> root; /* offset of the top node */
+   unsigned long long free_list,  /* offset of the first freed node */
+                      unused;     /* offset of the first node never used */
+   Relaxed<unsigned long long> occupancy; /* nodes in tree */
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        SharedTree
+
+Purpose:     Handle on a shared tree segment, either as its writer or as a
+             reader. Reads check the sequence before and after and repeat if
+             the writer changed the tree meanwhile, so readers never block the
+             writer and never take a lock. A read gives up if a change lasts
+             past SHARED_READ_WAIT or the writer process is gone, find and
+             entries then fail and stalled reports it.
+
+Data Fields: base:     start of the mapped segment
+             bytes:    size of the mapped segment
+             writer:   whether this handle created the segment and may change it
+             stuck:    whether the last read gave up on the writer
+
+Functions: SharedTree:  constructor
+           ~SharedTree: destructor, unmaps the segment
+           create:      make and map a new segment as its writer
+           open:        map an existing segment as a reader
+           close:       unmap the segment
+           destroy:     remove a segment by name
+           insert:      add nodes, writer only
+           remove:      take out nodes, writer only
+           find:        look for a node
+           entries:     copy all entries in ascending order
+           stalled:     whether the last read gave up on the writer
+           read_begin:  start a read, wait out any change
+           read_retry:  whether a read overlapped a change
+           first_node:  offset of the node of smallest entry
+           sucessor:    offset of the next node in ascending order
+           entry:       copy of the entry of a node
+           size:        nodes in tree
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class SharedTree
+{
+   private:
+      /* data fields */
+      char * base;                /* start of the mapped segment */
+      unsigned long long bytes;   /* size of the mapped segment */
+      bool writer;                /* may change the tree */
+      bool stuck;                 /* last read gave up on the writer */
+
+      /* functions */
+      SharedHeader * header(void); /* header at the start of the segment */
+      SharedNode * at(unsigned long long); /* node at an offset */
+      bool valid(unsigned long long); /* offset is a node slot */
+      unsigned int load_entry(unsigned long long, char *); /* copy out the
+                                                     entry of a node */
+      void store_entry(unsigned long long, const char *, unsigned int);
+                                   /* copy an entry into a node */
+      int compare(unsigned long long, const std :: string &); /* order the
+                                             entry of a node against another */
+      int height(unsigned long long); /* height of a node, -1 for null */
+      void update(unsigned long long); /* recompute height from children */
+      void rotate_left(unsigned long long); /* move right child up */
+      void rotate_right(unsigned long long); /* move left child up */
+      void retrace(unsigned long long); /* update and balance up to the root */
+      void replace(unsigned long long, unsigned long long); /* put a node in
+                                                            another's place */
+
+   public:
+      /* functions */
+      SharedTree(void); /* constructor for a handle with no segment */
+      ~SharedTree(void); /* destructor unmapping the segment */
+      bool create(const char *, unsigned int); /* make a segment of some nodes
+                                                */
+      bool open(const char *); /* map a segment read only */
+      void close(void); /* unmap the segment */
+      static bool destroy(const char *); /* remove a segment by name */
+      SharedInsert insert(const std :: string &); /* add nodes */
+      bool remove(const std :: string &); /* take out nodes */
+      bool find(const std :: string &); /* look for nodes */
+      bool entries(std :: vector<std :: string> &); /* all entries in order */
+      bool stalled(void); /* last read gave up on the writer */
+      bool read_begin(unsigned long long &); /* start a read */
+      bool read_retry(unsigned long long); /* read overlapped a change */
+      unsigned long long first_node(void); /* node of smallest entry */
+      unsigned long long sucessor(unsigned long long); /* next node */
+      std :: string entry(unsigned long long); /* entry of a node */
+      unsigned long long size(void); /* nodes in tree */
+};
+
+#endif
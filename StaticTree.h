@@ -0,0 +1,353 @@
+/*=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~
+                                                      Author: agent
+
+                                                      Date:   2026
+
+                                   StaticTree.h
+--------------------------------------------------------------------------------
+Purpose: This is the definition of the static tree, a read only balanced tree
+         of a fixed set of entries built while compiling. Its functions are
+         constexpr so they are defined here instead of in a .cpp file. Declared
+         constexpr, a static tree lives in read only data and costs nothing at
+         startup, and find and iteration work in constant expressions as well
+         as at runtime. Entries must be literal types ordered by <, use
+         std :: string_view for strings. A cursor stands in for the node
+         pointers of the tree class so the same loop walks either one:
+
+         constexpr StaticTree<std :: string_view, 3> commands =
+            make_static_tree<std :: string_view>({ "list", "add", "remove" });
+         static_assert(commands.find("add"), "add is a command");
+
+         for(auto node = commands.first_node(&commands); node;
+             node = node->sucessor(node))
+            std :: cout << node->entry << '\n';
+=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
+#ifndef STATICTREE_H
+#define STATICTREE_H
+#include<stdexcept>
+
+template<typename Data, unsigned int Size> class StaticTree; /* walked by the
+                                                               cursor below */
+
+template<typename Data, unsigned int Size> /* define template definition for
+                                              class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        StaticCursor
+
+Purpose:     Position of one entry in a static tree, used like a node pointer
+             of the tree class. It points to itself, and a cursor past the last
+             entry converts to false like a null node.
+
+Data Fields: tree:  tree the entry is in
+             index: index of the entry, Size past the last entry
+             entry: copy of the entry
+             count: occurrences of the entry, always 1
+
+Functions: StaticCursor: constructor
+           ->:           the cursor itself
+           bool:         whether the cursor is on an entry
+           sucessor:     cursor of the next entry in ascending order
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class StaticCursor
+{
+   public:
+      /* data fields */
+      const StaticTree<Data, Size> * tree; /* tree the entry is in */
+      unsigned int index;                  /* index of the entry */
+      Data entry;                          /* copy of the entry */
+      unsigned int count;                  /* occurrences of the entry */
+
+      /*------------------------------------------------------------------------
+      Name:       StaticCursor
+
+      Purpose:    Constructor for the cursor on an index, copying its entry.
+
+      Parameters: tree:  tree the entry is in
+                  index: index of the entry, Size past the last entry
+
+      Return:     none
+      ------------------------------------------------------------------------*/
+      constexpr StaticCursor(const StaticTree<Data, Size> * tree,
+                             unsigned int index)
+         : tree(tree), index(index),
+           entry(index < Size ? tree->entry(index) : Data()), count(1)
+      {
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       operator->
+
+      Purpose:    The cursor itself, so its fields read like those of a node.
+
+      Parameters: none
+
+      Return:     this cursor
+      ------------------------------------------------------------------------*/
+      constexpr const StaticCursor<Data, Size> * operator->() const
+      {
+         return this;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       operator bool
+
+      Purpose:    Whether the cursor is on an entry, false past the last one.
+
+      Parameters: none
+
+      Return:     status of whether there is an entry
+      ------------------------------------------------------------------------*/
+      constexpr explicit operator bool() const
+      {
+         return index < Size;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       sucessor
+
+      Purpose:    Cursor of the next entry in ascending order.
+
+      Parameters: cursor: cursor to find the sucessor of
+
+      Return:     cursor of the sucessor, false if there is none
+      ------------------------------------------------------------------------*/
+      constexpr StaticCursor<Data, Size> sucessor(
+         const StaticCursor<Data, Size> & cursor) const
+      {
+         return StaticCursor<Data, Size>(tree,
+                                         tree->sucessor(cursor.index));
+      }
+};
+
+template<typename Data, unsigned int Size> /* define template definition for
+                                              class below */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+Name:        StaticTree
+
+Purpose:     Balanced binary tree stored level by level in one array. The root
+             is at index 0 and the children of index i are at 2i + 1 and 2i + 2,
+             so there are no pointers and every level is full but the last.
+             Nodes are indexes, Size stands for no node, and cursors on them
+             walk the entries in order.
+
+Data Fields: entries: entries in level order
+
+Functions: StaticTree: constructor from a list of distinct entries
+           find:       look for an entry
+           size:       amount of entries
+           first_node: cursor of the smallest entry
+           first:      index of the smallest entry
+           sucessor:   index of the next entry in ascending order
+           entry:      entry at an index
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+class StaticTree
+{
+   static_assert(Size > 0, "a static tree needs at least one entry");
+
+   private:
+      /* data fields */
+      Data entries[Size]; /* entries in level order */
+
+      /*------------------------------------------------------------------------
+      Name:       place
+
+      Purpose:    Lay sorted entries out in level order by walking the indexes
+                  in order and handing out the sorted entries one by one.
+
+      Parameters: sorted: entries in ascending order
+                  index:  index of the subtree to fill
+                  next:   position of the next sorted entry to hand out
+
+      Return:     void
+      ------------------------------------------------------------------------*/
+      constexpr void place(const Data (&sorted)[Size], unsigned int index,
+                           unsigned int & next)
+      {
+         if(index >= Size)
+            return;
+
+         place(sorted, 2 * index + 1, next);
+         entries[index] = sorted[next++];
+         place(sorted, 2 * index + 2, next);
+      }
+
+   public:
+      /*------------------------------------------------------------------------
+      Name:       StaticTree
+
+      Purpose:    Sort a copy of the entries and lay them out in level order.
+                  Duplicate entries are not allowed, in a constant expression
+                  they stop compilation.
+
+      Parameters: list: entries of the tree in any order
+
+      Return:     none
+      ------------------------------------------------------------------------*/
+      constexpr StaticTree(const Data (&list)[Size]) : entries()
+      {
+         Data sorted[Size] = {}; /* entries in ascending order */
+         unsigned int next = 0; /* next sorted entry to place */
+
+         /* insertion sort, the lists are short and known ahead */
+         for(unsigned int i = 0; i < Size; ++i)
+         {
+            unsigned int j = i;
+
+            for(; j > 0 && list[i] < sorted[j - 1]; --j)
+               sorted[j] = sorted[j - 1];
+
+            sorted[j] = list[i];
+         }
+
+         /* neighbors in sorted order must differ */
+         for(unsigned int i = 1; i < Size; ++i)
+            if(!(sorted[i - 1] < sorted[i]))
+               throw std :: logic_error("duplicate entry in a static tree");
+
+         place(sorted, 0, next);
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       find
+
+      Purpose:    search for an entry from the root down
+
+      Parameters: entry: entry to be searched for
+
+      Return:     status of whether the entry is in the tree
+      ------------------------------------------------------------------------*/
+      constexpr bool find(const Data & entry) const
+      {
+         unsigned int index = 0; /* start at the root */
+
+         while(index < Size)
+         {
+            /* go right if the current entry is too small */
+            if(entries[index] < entry)
+               index = 2 * index + 2;
+            /* go left if the current entry is too big */
+            else if(entry < entries[index])
+               index = 2 * index + 1;
+            /* entry was found */
+            else
+               return true;
+         }
+
+         return false;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       size
+
+      Purpose:    Amount of entries in the tree.
+
+      Parameters: none
+
+      Return:     Size
+      ------------------------------------------------------------------------*/
+      constexpr unsigned int size() const
+      {
+         return Size;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       first_node
+
+      Purpose:    Cursor of the smallest entry, to walk the entries in order.
+
+      Parameters: tree: this tree
+
+      Return:     cursor of the smallest entry
+      ------------------------------------------------------------------------*/
+      constexpr StaticCursor<Data, Size> first_node(
+         const StaticTree<Data, Size> * tree) const
+      {
+         return StaticCursor<Data, Size>(tree, tree->first());
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       first
+
+      Purpose:    Index of the smallest entry, as far left as possible.
+
+      Parameters: none
+
+      Return:     index: index of the smallest entry
+      ------------------------------------------------------------------------*/
+      constexpr unsigned int first() const
+      {
+         unsigned int index = 0; /* start at the root */
+
+         while(2 * index + 1 < Size)
+            index = 2 * index + 1;
+
+         return index;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       sucessor
+
+      Purpose:    Index of the next entry in ascending order. With a right child
+                  it is the leftmost node below it, otherwise go up past every
+                  right child to the first parent reached from its left.
+
+      Parameters: index: index to find the sucessor of
+
+      Return:     index of the sucessor, Size if there is none
+      ------------------------------------------------------------------------*/
+      constexpr unsigned int sucessor(unsigned int index) const
+      {
+         /* has a right child, go as left as possible below it */
+         if(2 * index + 2 < Size)
+         {
+            index = 2 * index + 2;
+
+            while(2 * index + 1 < Size)
+               index = 2 * index + 1;
+
+            return index;
+         }
+
+         /* right children have even indexes, keep going up past them */
+         while(index > 0 && index % 2 == 0)
+            index = (index - 1) / 2;
+
+         /* came up to the root from the right, no sucessor */
+         if(index == 0)
+            return Size;
+
+         return (index - 1) / 2;
+      }
+
+      /*------------------------------------------------------------------------
+      Name:       entry
+
+      Purpose:    Entry held at an index.
+
+      Parameters: index: index of a node, below Size
+
+      Return:     entry at the index
+      ------------------------------------------------------------------------*/
+      constexpr const Data & entry(unsigned int index) const
+      {
+         return entries[index];
+      }
+};
+
+template<typename Data, unsigned int Size> /* define template definition for
+                                              function below */
+/*------------------------------------------------------------------------------
+Name:       make_static_tree
+
+Purpose:    Build a static tree from a braced list, deducing its size.
+
+Parameters: list: entries of the tree in any order
+
+Return:     static tree of the entries
+------------------------------------------------------------------------------*/
+constexpr StaticTree<Data, Size> make_static_tree(const Data (&list)[Size])
+{
+   return StaticTree<Data, Size>(list);
+}
+
+#endif
@@ -9,39 +9,56 @@ Purpose: This file contains all the functions of a binary tree including a
          balancing feature found in an avl tree. The tree is made up of nodes
          which are defined in Node.h each having left, right, and parent
          pointers to strcture the entire tree. Nodes can be inserted by less 
-         than and greater than properties. Duplicate insert is not allowed.
+         than and greater than properties. Duplicate insert is not allowed
+         unless the tree is a multiset, where every node counts the
+         occurrences of its entry and duplicates only change that count.
          Nodes can also be searched for and removed. The destructor implements
          an iterative deletion process of each individual node. Upon insert and
          remove, node members are updated along with the datafields of the tree.
-         Rotation is implemented upon insert if a node falls outside of the
-         balance threshold. This is where nodes are removed and inserted again.
+         Rotation is implemented upon insert and remove if a node falls outside
+         of the balance threshold, which is a template parameter. A threshold
+         of 1 is a strict avl tree, larger thresholds allow deeper paths in
+         exchange for fewer rotations. Single or double rotations are picked
+         by which way the taller child leans.
          The tree can also be printed node by node. It does this iteratively by
          starting at a defined first node by the tree and constantly calling
-         the sucessor node implemented in Node.cpp.
+         the sucessor node implemented in Node.cpp. Printing goes through the
+         buffered export in Export.h, which also writes entries alone,
+         Graphviz DOT and JSON to any stream or file. An optional bloom filter
+         kept alongside the nodes lets find return at once for entries that
+         are surely absent, and an optional lookup cache maps entries found
+         often straight to their nodes.
 =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~*/
 #include "Tree.h"
+#include "Hash.h"
 #include<iostream>
+#include<fstream>
+#include<vector>
+#include<utility>
 
-static const unsigned int BALANCE_THRESHOLD = 2; /* balance factor allowed by 
-                                                    this tree */
-
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       Tree
 
 Purpose:    Tree constructor for this object
 
-Parameters: none
+Parameters: multiset: whether duplicate entries are counted instead of 
+                      rejected
  
 Return:     none
 ------------------------------------------------------------------------------*/
-Tree<Data> :: Tree()
+Tree<Data, Threshold> :: Tree(bool multiset)
 {
    /* all data values of tree default to 0 */
-   occupancy = height = depth = width = 0;
+   occupancy = height = depth = width = entries = 0;
+   rotations = 0; /* no rotations yet */
+   filter = 0; /* no bloom filter unless enabled */
+   cache = 0; /* no lookup cache unless enabled */
+   root = 0; /* no nodes yet */
+   this->multiset = multiset; /* duplicate handling */
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       ~Tree
 
@@ -52,13 +69,15 @@ Parameters: none
 
 Return:     none
 ------------------------------------------------------------------------------*/
-Tree<Data> :: ~Tree()
+Tree<Data, Threshold> :: ~Tree()
 {
    /* delegate to function that deletes the nodes of this tree */
    delete_nodes(root);
+   delete filter;
+   delete cache;
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       insert
 
@@ -67,7 +86,8 @@ Purpose:    Nodes are inserted to the binary tree based on less than or greater
             already in the tree. This takes care of node and tree data values
             as inserting modifies the tree. Rotate is called upon an unbalanced
             node. Duplicate insert is not allowed and will cause this function 
-            to return false.
+            to return false, unless this tree is a multiset where the count of
+            the node already holding the entry is incremented instead.
 
 Parameters: entry: the data value via generic to be held by the node attempting 
                    to be inserted
@@ -75,12 +95,14 @@ Parameters: entry: the data value via generic to be held by the node attempting
 Return:     inserted: sucess or failure of insertion of a node with the given
                       entry
 ------------------------------------------------------------------------------*/
-bool Tree<Data> :: insert(Data entry)
+bool Tree<Data, Threshold> :: insert(Data entry)
 {
    Node<Data> * current; /* current node as insertion traverses tree */
    Node<Data> * new_node = 0; /* node to be assigned once and if inserted */
    bool inserted = false; /* return status of insertion */
-   unsigned int traversals = 0; /* amount of levels traversed into the tree */
+   KeyPrefix<Data> key(entry); /* prefix of the entry, made once for every 
+                                  comparison below */
+   int order; /* current's entry compared to the entry */
 
    /* case for empty tree, assign the root to be node inserted */
    if(occupancy == 0)
@@ -89,6 +111,7 @@ bool Tree<Data> :: insert(Data entry)
       current = root;
       current->width = 1;
       ++occupancy;
+      ++entries;
       ++depth;
       ++width;
       inserted = true; 
@@ -100,17 +123,24 @@ bool Tree<Data> :: insert(Data entry)
    /* continue traversing tree until inserted, should be inserted at bottom */
    while(!inserted)
    {
-      /* node with entry was found so loop terminates with insertion set to
-         failed */
-      if(current->entry == entry)
-         break;
+      order = current->compare(entry, key);
 
-      /* increment amount of traversals going down the tree */
-      ++traversals;
+      /* node with entry was found, a multiset counts another occurrence
+         without changing the structure, otherwise the loop terminates with
+         insertion set to failed */
+      if(order == 0)
+      {
+         if(!multiset)
+            break;
+
+         ++current->count;
+         ++entries;
+         return true;
+      }
 
       /* go right if entry to be inserted is greater than entry where current 
          points to */
-      if(current->entry < entry)
+      if(order < 0)
       {
          /* null spot not found, keep going right */
          if(current->right)
@@ -122,14 +152,14 @@ bool Tree<Data> :: insert(Data entry)
             current->right = new Node<Data>(entry);
             current->right->parent = current;
             current = current->right;
-            current->level = traversals;
             ++occupancy;
+            ++entries;
             inserted = true;
          } 
       }
       /* go left if entry to be inserted is less than entry where current points
          to */
-      else if(current->entry > entry)
+      else if(order > 0)
       {
          /* null spot not found, keep going left */
          if(current->left)
@@ -141,210 +171,129 @@ bool Tree<Data> :: insert(Data entry)
             current->left = new Node<Data>(entry);
             current->left->parent = current;
             current = current->left;
-            current->level = traversals;
             ++occupancy;
+            ++entries;
             inserted = true;
          }
       }
 
    }
 
-   /* case where current height and depth have to be incremented because 
-      traversal went further down than previous version of this tree */
-   if(height < traversals)
-   {
-      height = traversals;
-      depth = height + 1;
-   }
+   /* duplicate entry, nothing changed */
+   if(!inserted)
+      return inserted;
 
    new_node = current; /* save node just inserted */
-   unsigned int up_traversals = 0; /* we have up traversals to update fields of
-                                      parent nodes of node just inserted */
 
-   /* traverse up the tree to update fields of above nodes since they were all 
-      affected */
-   do
-   {
-      /* go up the tree using parent pointers to u pdate current node in up 
-         traversals */
-      if(current->parent)
-      {
-         current = current->parent;
-         ++up_traversals;
-      }
-      /* all parent are already taken care of */
-      else
-         break;
-      
-      /* case to having to increment height and depth since up traversal is 
-         greater than current height and depth*/
-      if(up_traversals > current->height)
-      {
-         ++current->height;
-         ++current->depth;
-
-      }
+   /* new entry goes in the bloom filter */
+   if(filter)
+      filter->add(hash_entry(entry));
 
-      /* update balances of each node, 3 cases are valid depending on children,
-         balance = right's height - left's height */
-      if(!current->right && current->left) /* only left child */
-         current->balance = (-1 * current->left->height) - 1;
-      else if(current->right && !current->left) /* only right child */
-         current->balance = current->right->height + 1;
-      else if(current->right && current->left) /* 2 children present */
-         current->balance = current->right->height - current->left->height;
-   }
-   while(true);
+   /* update fields of the nodes above the new node, rotating any node pushed
+      outside the balance threshold */
+   retrace(new_node->parent);
 
    /* return status of sucessful insertion */
    return inserted;
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       remove
 
 Purpose:    Remove a node given an entry. This modifies tree structure therefore
             data fields of this tree and any surrounding nodes are affected and
             must be updated as such. Remooval will fail if the given entry is
-            not in the tree.
+            not in the tree. In a multiset, an entry occurring more than once
+            only has its count decremented and the node stays.
 
 Parameters: entry: the data value via generic of the node looking for removal
                    from this tree
 
 Return:     removed: status of whether a node was removed
 ------------------------------------------------------------------------------*/
-bool Tree<Data> :: remove(Data entry)
+bool Tree<Data, Threshold> :: remove(Data entry)
 {
    Node<Data> * current; /* current node being pointed to during traversal of 
                             this tree */
    bool removed = false; /* status of node being removed */
 
+   /* search the tree for the node with the given entry */
+   current = search(entry);
+
    /* empty tree or node not in the tree causes a failure to be returned */
-   if(occupancy == 0 || !find(entry))
+   if(!current)
       return removed;
-   /* set the current node to the root and search for the node to remove from 
-      here */
-   else
-      current = root;
 
-   /* search the tree until the node with the given entry is found */
-   while(current->entry != entry)
+   /* one of several occurrences is removed, node stays in place */
+   if(current->count > 1)
    {
-      /* current entry is bigger */
-      if(current->entry > entry)
-         current = current->left;
-      /* current entry is smaller */
-      else if(current->entry < entry)
-         current = current->right;
+      --current->count;
+      --entries;
+      return true;
    }
 
-   /* edge case where the root is being removed; specialized to avoid seg 
-      faulting the tree due to an empty root */
-   if(current == root)
-   {
-      /* root is a leaf node */
-      if(!current->left && !current->right)
-         root = NULL;
-      /* root only has a right child */
-      else if(!current->left && current->right)
-         root = current->right;
-      /* root only has a left child */
-      else if(!current->right && current->left)
-         root = current->left;
-      /* root has 2 children */
-      else if(current->left && current->right)
-      {
-         /* look for sucessor to replace node to be removed */
-         current = current->left;
-
-         while(current->right)
-            current = current->right;
-
-         /* only entry is updated since the node is actually in the same place
-            only having a different entry, more efficient than deleting the node
-            to be removed */
-         root->entry = current->entry;
-
-         /* adjust pointers of the sucessor node after swapping nodes */
-         if(current->parent->right == current)
-            current->parent->right = NULL;
-         if(current->parent->left == current)
-            current->parent->left = NULL;
-      }
-   }
-   /* node removal does not target the root */
-   /* leaf node */
-   else if(!current->left && !current->right)
-   {
-      if(current->parent->right == current)
-         current->parent->right = NULL;
-      else if(current->parent->left == current)
-         current->parent->left = NULL;
-   }
-   /* has a right child */
-   else if(current->right && !current->left)
-   {
-      /* right parent pointer adjustment */
-      if(current->parent->right == current)
-      {
-         current->parent->right = current->right;
-         current->right->parent = current->parent;
-      }
-      /* left parent pointer adjustment */
-      else if(current->parent->left == current)
-      {
-         current->parent->left = current->right;
-         current->right->parent = current->parent;
-      }
-   }
-   /* has a left child */
-   else if(!current->right && current->left)
-   {
-      /* right parent pointer adjustment */
-      if(current->parent->right == current)
-      {
-         current->parent->right = current->left;
-         current->left->parent = current->parent;
-      }
-      /* left parent pointer adjustment */
-      else if(current->parent->left == current)
-      
-      {
-         current->parent->left = current->left;
-         current->left->parent = current->parent;
-      }
-   }
-   /* has both children */
-   else if(current->right && current->left)
+   /* has both children, the entry of the predecessor node takes the place of
+      the entry being removed and the predecessor node is removed instead */
+   if(current->left && current->right)
    {
-      Node<Data> * original = current; /* node to be removed and swapped */
+      Node<Data> * original = current; /* node keeping its place */
       current = current->left;
 
-      /* find sucessor node to swap with original node */
+      /* find the predecessor, as right as possible in the left subtree */
       while(current->right)
          current = current->right;
 
       /* update only the entry since the node is in the same place with only a
          different name but with same numerical fields */
       original->entry = current->entry;
+      original->set_prefix(original->entry);
+      original->count = current->count;
+   }
+
+   /* current now has at most one child which takes its place */
+   Node<Data> * child = current->left ? current->left : current->right;
+   Node<Data> * parent = current->parent; /* lowest node affected */
+
+   if(child)
+      child->parent = parent;
 
-      /* adjust pointers of sucessor after swapping */
-      if(current->parent->right == current)
-         current->parent->right = NULL;
-      else if(current->parent->left == current)
-         current->parent->left = NULL;
+   /* removing the root, the child becomes the root */
+   if(!parent)
+      root = child;
+   /* right parent pointer adjustment */
+   else if(parent->right == current)
+      parent->right = child;
+   /* left parent pointer adjustment */
+   else
+      parent->left = child;
+
+   /* cached pointers to the deleted node, or to a node whose entry changed,
+      go before the node does */
+   if(cache)
+   {
+      cache->invalidate(hash_entry(entry));
+      cache->invalidate(hash_entry(current->entry));
    }
 
    delete current; /* delete node that has been removed */
    --occupancy; /* decrement occupancy */
+   --entries; /* last occurrence of the entry is gone */
    removed = true; /* set removed to true */
-   
+
+   /* last occurrence leaves the bloom filter */
+   if(filter)
+      filter->remove(hash_entry(entry));
+
+   /* update fields of the nodes above the removed node, rotating any node
+      pushed outside the balance threshold */
+   retrace(parent);
+
    /* return status of removal */
    return removed;
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       find
 
@@ -354,28 +303,45 @@ Parameters: entry: node carrying this entry to be searched for
 
 Return:     found: status of whether node with the given entry is in the tree
 ------------------------------------------------------------------------------*/
-bool Tree<Data> :: find(Data entry)
+bool Tree<Data, Threshold> :: find(Data entry)
 {
    Node<Data> * current; /* current node in traversal of tree */
    bool found = false; /* status of whether the node containing the entry was 
                           found */
+   KeyPrefix<Data> key(entry); /* prefix of the entry, made once */
+   int order; /* current's entry compared to the entry */
+   unsigned long long hash = 0; /* hash of the entry for the cache and filter 
+                                   */
 
    /* empty tree, nothing can be found */
    if(occupancy == 0)
       return found;
 
+   if(filter || cache)
+      hash = hash_entry(entry);
+
+   /* entry found recently, its node is cached */
+   if(cache && cache->lookup(hash, entry))
+      return true;
+
+   /* bloom filter says the entry is surely absent, skip the search */
+   if(filter && !filter->may_contain(hash))
+      return found;
+
    /* start searching from the root */
    current = root;
 
    /* continue this loop while the node is not found */
    while(!found)
    {
+      order = current->compare(entry, key);
+
       /* node was found */
-      if(current->entry == entry)
+      if(order == 0)
          found = true;
 
       /* go right if the current entry is too small */
-      else if(current->entry < entry)
+      else if(order < 0)
       {
          /* break at a leaf node, find fails */
          if(!current->right)
@@ -385,7 +351,7 @@ bool Tree<Data> :: find(Data entry)
       }
       
       /* go left if the current entry is too big */
-      else if(current->entry > entry)
+      else if(order > 0)
       {
          /* break at a leaf node, find fails */
          if(!current->left)
@@ -395,11 +361,312 @@ bool Tree<Data> :: find(Data entry)
       }
    }
 
+   /* bloom filter passed an entry that is absent */
+   if(filter && !found)
+      filter->record_miss();
+
+   /* cache the node found for the next find of this entry */
+   if(cache && found)
+      cache->store(hash, current);
+
    /* return status of whether node with the given entry is in the tree */
    return found;
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       search
+
+Purpose:    Return the node holding the given entry by walking down from the
+            root.
+
+Parameters: entry: entry of the node to search for
+
+Return:     current: node holding the entry, null if it is not in the tree
+------------------------------------------------------------------------------*/
+Node<Data> * Tree<Data, Threshold> :: search(Data entry)
+{
+   Node<Data> * current = root; /* start searching from the root */
+   KeyPrefix<Data> key(entry); /* prefix of the entry, made once */
+   int order; /* current's entry compared to the entry */
+
+   /* go left or right until the entry is found or a null child is hit */
+   while(current && (order = current->compare(entry, key)) != 0)
+   {
+      if(order < 0)
+         current = current->right;
+      else
+         current = current->left;
+   }
+
+   return current;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       range
+
+Purpose:    Count the entries from low to high, both included. The search goes
+            down to the smallest node not below low, then follows sucessors
+            until an entry passes high.
+
+Parameters: low:  smallest entry counted
+            high: largest entry counted
+
+Return:     found: entries in the range counting every occurrence
+------------------------------------------------------------------------------*/
+unsigned int Tree<Data, Threshold> :: range(Data low, Data high)
+{
+   Node<Data> * current = root; /* start searching from the root */
+   Node<Data> * first = 0; /* smallest node not below low so far */
+   KeyPrefix<Data> key(low); /* prefix of low, made once */
+   KeyPrefix<Data> high_key(high); /* prefix of high, made once */
+   unsigned int found = 0; /* entries in the range */
+
+   /* smaller nodes go right, others may be the first and go left */
+   while(current)
+   {
+      if(current->compare(low, key) < 0)
+         current = current->right;
+      else
+      {
+         first = current;
+         current = current->left;
+      }
+   }
+
+   /* count nodes in order until one passes high */
+   for(current = first; current && current->compare(high, high_key) <= 0;
+       current = current->sucessor(current))
+      found += current->count;
+
+   return found;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       count
+
+Purpose:    Occurrences of the given entry in this tree. Without multiset this 
+            is either 0 or 1.
+
+Parameters: entry: entry to count
+
+Return:     occurrences of the entry
+------------------------------------------------------------------------------*/
+unsigned int Tree<Data, Threshold> :: count(Data entry)
+{
+   Node<Data> * node = search(entry); /* node holding the entry */
+
+   /* absent entries occur 0 times */
+   if(!node)
+      return 0;
+
+   return node->count;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       size
+
+Purpose:    Amount of entries in this tree counting every occurrence, equal to
+            occupancy unless this tree is a multiset.
+
+Parameters: none
+
+Return:     entries: entries counting every occurrence
+------------------------------------------------------------------------------*/
+unsigned int Tree<Data, Threshold> :: size()
+{
+   return entries;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       tree_height
+
+Purpose:    Height of this tree, the most nodes below the root on any path.
+
+Parameters: none
+
+Return:     height: height of the tree
+------------------------------------------------------------------------------*/
+unsigned int Tree<Data, Threshold> :: tree_height()
+{
+   return height;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       rotation_count
+
+Purpose:    Single rotations done since this tree was made, a double rotation
+            counts as 2.
+
+Parameters: none
+
+Return:     rotations: rotations done
+------------------------------------------------------------------------------*/
+unsigned long Tree<Data, Threshold> :: rotation_count()
+{
+   return rotations;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       average_level
+
+Purpose:    Average level of the nodes in this tree, the amount of steps a
+            successful find takes on average. Levels are counted by walking up
+            from each node.
+
+Parameters: none
+
+Return:     average level, 0 for an empty tree
+------------------------------------------------------------------------------*/
+double Tree<Data, Threshold> :: average_level()
+{
+   double levels = 0; /* sum of the levels of all nodes */
+
+   /* empty tree has no levels */
+   if(occupancy == 0)
+      return 0;
+
+   for(Node<Data> * node = first_node(this); node; node = node->sucessor(node))
+      for(Node<Data> * above = node->parent; above; above = above->parent)
+         ++levels;
+
+   return levels / occupancy;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       enable_filter
+
+Purpose:    Keep a bloom filter alongside the nodes so find can skip searching
+            for entries that are surely absent. Any filter already kept is 
+            replaced, so calling this again rebuilds it, for instance once the
+            tree has grown past what it was sized for. All entries already in
+            the tree are added.
+
+Parameters: expected: amount of distinct entries the filter is sized for
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: enable_filter(unsigned int expected)
+{
+   delete filter;
+
+   /* never size for fewer entries than already held */
+   if(expected < occupancy)
+      expected = occupancy;
+
+   filter = new BloomFilter(expected);
+
+   for(Node<Data> * node = first_node(this); node; node = node->sucessor(node))
+      filter->add(hash_entry(node->entry));
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       disable_filter
+
+Purpose:    Stop keeping a bloom filter, every find searches the tree again.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: disable_filter()
+{
+   delete filter;
+   filter = 0;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       filter_false_positive_rate
+
+Purpose:    Measured share of finds of absent entries that the bloom filter
+            failed to stop, since the filter was enabled.
+
+Parameters: none
+
+Return:     false positive rate, 0 without a filter or absent finds
+------------------------------------------------------------------------------*/
+double Tree<Data, Threshold> :: filter_false_positive_rate()
+{
+   if(!filter)
+      return 0;
+
+   return filter->false_positive_rate();
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       enable_cache
+
+Purpose:    Keep a lookup cache in front of find mapping entries found to their
+            nodes, so entries found often skip the search. Any cache already 
+            kept is replaced by an empty one.
+
+Parameters: slots: amount of slots, rounded up to a power of 2
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: enable_cache(unsigned int slots)
+{
+   delete cache;
+   cache = new LookupCache<Data>(slots);
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       disable_cache
+
+Purpose:    Stop keeping a lookup cache, every find searches the tree again.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: disable_cache()
+{
+   delete cache;
+   cache = 0;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       cache_hits
+
+Purpose:    Finds answered by the lookup cache since it was enabled.
+
+Parameters: none
+
+Return:     hits, 0 without a cache
+------------------------------------------------------------------------------*/
+unsigned long long Tree<Data, Threshold> :: cache_hits()
+{
+   return cache ? cache->hit_count() : 0;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       cache_misses
+
+Purpose:    Finds the lookup cache could not answer since it was enabled.
+
+Parameters: none
+
+Return:     misses, 0 without a cache
+------------------------------------------------------------------------------*/
+unsigned long long Tree<Data, Threshold> :: cache_misses()
+{
+   return cache ? cache->miss_count() : 0;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       delete_nodes
 
@@ -410,7 +677,7 @@ Parameters: node: should be the root node for all nodes to be sucessfully freed
 
 Return:     void
 ------------------------------------------------------------------------------*/
-void Tree<Data> :: delete_nodes(Node<Data> * node)
+void Tree<Data, Threshold> :: delete_nodes(Node<Data> * node)
 {
    /* return if the tree is already empty */
    if(!node)
@@ -422,7 +689,7 @@ void Tree<Data> :: delete_nodes(Node<Data> * node)
    delete node;
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       rotate
 
@@ -434,12 +701,178 @@ Parameters: node: node to be rotated from
 
 Return:     void
 ------------------------------------------------------------------------------*/
-void Tree<Data> :: rotate(Node<Data> * node)
+void Tree<Data, Threshold> :: rotate(Node<Data> * node)
 {
-   /* TODO */
+   /* right side too tall */
+   if(node->balance > (int)Threshold)
+   {
+      /* right child leans left, turn it to lean right first */
+      if(node->right->balance < 0)
+         rotate_right(node->right);
+
+      rotate_left(node);
+   }
+   /* left side too tall */
+   else if(node->balance < -(int)Threshold)
+   {
+      /* left child leans right, turn it to lean left first */
+      if(node->left->balance > 0)
+         rotate_left(node->left);
+
+      rotate_right(node);
+   }
 }
 
-template<typename Data> /* define template definition for function below */
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       rotate_left
+
+Purpose:    Single rotation moving the right child of the node up into its
+            place. The node becomes the left child of its old right child, which
+            hands its left subtree over to the node.
+
+Parameters: node: node to be rotated down
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: rotate_left(Node<Data> * node)
+{
+   Node<Data> * pivot = node->right; /* node moving up */
+
+   /* left subtree of the pivot moves under the node */
+   node->right = pivot->left;
+   if(pivot->left)
+      pivot->left->parent = node;
+
+   /* pivot takes the place of the node under its parent */
+   pivot->parent = node->parent;
+   if(!node->parent)
+      root = pivot;
+   else if(node->parent->left == node)
+      node->parent->left = pivot;
+   else
+      node->parent->right = pivot;
+
+   /* node goes under the pivot */
+   pivot->left = node;
+   node->parent = pivot;
+
+   /* lower node first since the pivot's fields depend on it */
+   update(node);
+   update(pivot);
+   ++rotations;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       rotate_right
+
+Purpose:    Single rotation moving the left child of the node up into its
+            place. The node becomes the right child of its old left child, which
+            hands its right subtree over to the node.
+
+Parameters: node: node to be rotated down
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: rotate_right(Node<Data> * node)
+{
+   Node<Data> * pivot = node->left; /* node moving up */
+
+   /* right subtree of the pivot moves under the node */
+   node->left = pivot->right;
+   if(pivot->right)
+      pivot->right->parent = node;
+
+   /* pivot takes the place of the node under its parent */
+   pivot->parent = node->parent;
+   if(!node->parent)
+      root = pivot;
+   else if(node->parent->left == node)
+      node->parent->left = pivot;
+   else
+      node->parent->right = pivot;
+
+   /* node goes under the pivot */
+   pivot->right = node;
+   node->parent = pivot;
+
+   /* lower node first since the pivot's fields depend on it */
+   update(node);
+   update(pivot);
+   ++rotations;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       update
+
+Purpose:    Recompute the height, depth and balance of a node from its children.
+            Balance is right's height minus left's height where a missing child
+            counts as a height of -1.
+
+Parameters: node: node to update
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: update(Node<Data> * node)
+{
+   int right_height = node->right ? (int)node->right->height : -1;
+   int left_height = node->left ? (int)node->left->height : -1;
+
+   node->height = (right_height > left_height ? right_height : left_height) + 1;
+   node->depth = node->height + 1;
+   node->balance = right_height - left_height;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       retrace
+
+Purpose:    Walk up from the lowest node changed by an insert or remove,
+            updating each node and rotating any node whose balance falls
+            outside the threshold. Once a node keeps its old height nothing
+            above it can change, so the walk stops there. Tree height and depth
+            are taken from the root afterwards.
+
+Parameters: node: lowest node whose children changed, null for none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: retrace(Node<Data> * node)
+{
+   while(node)
+   {
+      unsigned int old_height = node->height; /* height before the change */
+
+      update(node);
+
+      /* outside the threshold, the node moves down and its replacement is now
+         its parent */
+      if(node->balance > (int)Threshold || node->balance < -(int)Threshold)
+      {
+         rotate(node);
+         node = node->parent;
+      }
+
+      /* subtree kept its height, nodes above are unaffected */
+      if(node->height == old_height)
+         break;
+
+      node = node->parent;
+   }
+
+   /* tree fields follow the root */
+   if(root)
+   {
+      height = root->height;
+      depth = height + 1;
+   }
+   else
+      height = depth = width = 0;
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
 /*------------------------------------------------------------------------------
 Name:       first_node
 
@@ -451,7 +884,7 @@ Parameters: tree: this tree
 
 Return:     node: the node of the smallest entry in the tree    
 ------------------------------------------------------------------------------*/
-Node<Data> * Tree<Data> :: first_node(Tree<Data> * tree)
+Node<Data> * Tree<Data, Threshold> :: first_node(Tree<Data, Threshold> * tree)
 {
    Node<Data> * node = 0; /* node to return defaulted to 0 incase of a null tree
                              */
@@ -473,55 +906,349 @@ Node<Data> * Tree<Data> :: first_node(Tree<Data> * tree)
 
 template<typename Data> /* define template definition for function below */
 /*------------------------------------------------------------------------------
-Name:       print_tree
+Name:       export_node
 
-Purpose:    Print all nodes of the tree in ascending order of entry along with
-            datafields of each node and the tree itself.
+Purpose:    Write the attributes of a node as one line, the same listing 
+            print_node gives, with the level counted from the parents.
 
-Parameters: none
+Parameters: buffer: buffer to write to
+            node:   node to have its values written
 
 Return:     void
 ------------------------------------------------------------------------------*/
-void Tree<Data> :: print_tree()
+static void export_node(ExportBuffer & buffer, Node<Data> * node)
 {
-   Tree<Data> * tree = this; /* printing nodes of this tree */
-   Node<Data> * node = tree->first_node(tree); /* start at the first node by 
-                                                  delegating to the function 
-                                                  that returns it*/
-   unsigned int count = 1; /* starting count */
+   unsigned int level = 0; /* steps from the root to the node */
+
+   for(Node<Data> * above = node->parent; above; above = above->parent)
+      ++level;
+
+   /* data fields of the node */
+   buffer.put_entry(node->entry);
+   buffer.put(" :: height: ");
+   buffer.put(node->height);
+   buffer.put(" :: width: ");
+   buffer.put(node->width);
+   buffer.put(" :: level: ");
+   buffer.put(level);
+   buffer.put(" :: depth: ");
+   buffer.put(node->depth);
+   buffer.put(" :: balance: ");
+   buffer.put(node->balance);
+   buffer.put(" :: count: ");
+   buffer.put(node->count);
+
+   /* pointers from this node */
+   buffer.put(" :: parent: ");
+   if(node->parent)
+      buffer.put_entry(node->parent->entry);
+   else
+      buffer.put("NULL");
 
-   /* print tree datafileds */
-   std :: cout << "Tree attributes :: occupancy: " << occupancy 
-               << " :: height: " << height << " :: depth: " << depth 
-               << " :: width: " << width << '\n' << std :: endl;
+   buffer.put(" :: right: ");
+   if(node->right)
+      buffer.put_entry(node->right->entry);
+   else
+      buffer.put("NULL");
 
-   /* if tree is empty, say so and terminate */
-   if(occupancy == 0)
+   buffer.put(" :: left: ");
+   if(node->left)
+      buffer.put_entry(node->left->entry);
+   else
+      buffer.put("NULL");
+
+   buffer.put('\n');
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_json
+
+Purpose:    Write the nodes below the given root as nested JSON objects. The 
+            walk follows parent pointers instead of recursing so a deep tree
+            cannot run out of stack.
+
+Parameters: buffer: buffer to write to
+            root:   top node to write
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void export_json(ExportBuffer & buffer, Node<Data> * root)
+{
+   Node<Data> * node = root; /* node being written */
+   Node<Data> * previous = root->parent; /* node the walk came from */
+
+   while(node != root->parent)
    {
-      std :: cout << "The tree is empty!" << std :: endl;
-      return;
+      /* came down from the parent, open the object and go left */
+      if(previous == node->parent)
+      {
+         buffer.put("{\"entry\":");
+         buffer.put_json(node->entry);
+         buffer.put(",\"count\":");
+         buffer.put(node->count);
+         buffer.put(",\"height\":");
+         buffer.put(node->height);
+         buffer.put(",\"balance\":");
+         buffer.put(node->balance);
+         buffer.put(",\"left\":");
+
+         previous = node;
+         if(node->left)
+         {
+            node = node->left;
+            continue;
+         }
+         buffer.put("null");
+      }
+
+      /* left side done, go right */
+      if(previous == node || previous == node->left)
+      {
+         buffer.put(",\"right\":");
+
+         previous = node;
+         if(node->right)
+         {
+            node = node->right;
+            continue;
+         }
+         buffer.put("null");
+      }
+
+      /* both sides done, close the object and go back up */
+      buffer.put('}');
+      previous = node;
+      node = node->parent;
    }
+}
+
+template<typename Data> /* define template definition for function below */
+/*------------------------------------------------------------------------------
+Name:       export_dot
+
+Purpose:    Write the nodes below the given root as Graphviz nodes and edges.
+            Nodes are named by their number in pre order and labeled with their
+            entry, so entries that print alike still get nodes of their own.
+            Nodes still to be written wait on a stack with the number of their
+            parent instead of recursing.
+
+Parameters: buffer: buffer to write to
+            root:   top node to write
+
+Return:     void
+------------------------------------------------------------------------------*/
+static void export_dot(ExportBuffer & buffer, Node<Data> * root)
+{
+   std :: vector<std :: pair<Node<Data> *, unsigned int> > pending; /* nodes
+                                           to write and their parent number */
+   unsigned int number = 0; /* number of the next node */
+
+   pending.push_back(std :: make_pair(root, 0u));
 
-   /* this will print all nodes in the tree using the sucessor of the current 
-      node during the listing iteration */
-   while(node->sucessor(node))
+   while(!pending.empty())
    {
-      std :: cout << count << ". ";
-      node->print_node(node); /* call print_node passing in the current node */
-      node = node->sucessor(node); /* update node */
-      ++count; /* update count */
+      Node<Data> * node = pending.back().first; /* node being written */
+      unsigned int parent = pending.back().second; /* number of its parent */
+      unsigned int id = number++; /* number of this node */
+
+      pending.pop_back();
+
+      /* node labeled with its entry and any count */
+      buffer.put("   n");
+      buffer.put(id);
+      buffer.put(" [label=");
+      buffer.put_dot(node->entry);
+      if(node->count > 1)
+      {
+         buffer.put(", xlabel=\"x");
+         buffer.put(node->count);
+         buffer.put('"');
+      }
+      buffer.put("];\n");
+
+      /* edge from the parent */
+      if(node != root)
+      {
+         buffer.put("   n");
+         buffer.put(parent);
+         buffer.put(" -> n");
+         buffer.put(id);
+         buffer.put(node == node->parent->left ? " [label=\"L\"];\n"
+                                               : " [label=\"R\"];\n");
+      }
+
+      /* left is taken off first */
+      if(node->right)
+         pending.push_back(std :: make_pair(node->right, id));
+      if(node->left)
+         pending.push_back(std :: make_pair(node->left, id));
    }
- 
-   /* print the final node */
-   std :: cout << count << ". ";
-   node->print_node(node);
-}
-
-/* define all types for the template class */
-template class Tree<char>; /* tree of chars */
-template class Tree<short>; /* tree of shorts */
-template class Tree<int>; /* tree of ints */
-template class Tree<float>; /* tree of floats */
-template class Tree<double>; /* tree of doubles */
-template class Tree<long>; /* tree of longs */
-template class Tree<std :: string>; /* tree of strings */
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       export_tree
+
+Purpose:    Write this tree to a stream in the given format. Text is gathered in
+            a large buffer and written in blocks with no flush per line.
+            EXPORT_KEYS lists entries in ascending order, once per occurrence.
+            EXPORT_NODES lists the tree attributes and every node as print_tree
+            does. EXPORT_DOT writes a Graphviz digraph of numbered nodes
+            labeled by entry, with edges labeled L and R. EXPORT_JSON writes the
+            tree attributes and the nodes nested from the root.
+
+Parameters: out:    stream to write to
+            format: format to write in
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: export_tree(std :: ostream & out,
+                                          ExportFormat format)
+{
+   ExportBuffer buffer(out); /* buffer writing to the stream */
+   Node<Data> * node = first_node(this); /* start at the first node */
+   unsigned int count = 1; /* starting count */
+
+   switch(format)
+   {
+      case EXPORT_KEYS:
+         /* every occurrence of every entry in order */
+         for(; node; node = node->sucessor(node))
+            for(unsigned int i = 0; i < node->count; ++i)
+            {
+               buffer.put_key(node->entry);
+               buffer.put('\n');
+            }
+         break;
+
+      case EXPORT_NODES:
+         /* tree datafields */
+         buffer.put("Tree attributes :: occupancy: ");
+         buffer.put(occupancy);
+         buffer.put(" :: entries: ");
+         buffer.put(entries);
+         buffer.put(" :: height: ");
+         buffer.put(height);
+         buffer.put(" :: depth: ");
+         buffer.put(depth);
+         buffer.put(" :: width: ");
+         buffer.put(width);
+         buffer.put("\n\n");
+
+         /* if tree is empty, say so */
+         if(occupancy == 0)
+            buffer.put("The tree is empty!\n");
+
+         /* every node numbered in order */
+         for(; node; node = node->sucessor(node), ++count)
+         {
+            buffer.put(count);
+            buffer.put(". ");
+            export_node(buffer, node);
+         }
+         break;
+
+      case EXPORT_DOT:
+         buffer.put("digraph tree {\n");
+
+         /* nodes numbered from the root down */
+         if(root)
+            export_dot(buffer, root);
+
+         buffer.put("}\n");
+         break;
+
+      case EXPORT_JSON:
+         /* tree datafields */
+         buffer.put("{\"occupancy\":");
+         buffer.put(occupancy);
+         buffer.put(",\"entries\":");
+         buffer.put(entries);
+         buffer.put(",\"height\":");
+         buffer.put(height);
+         buffer.put(",\"depth\":");
+         buffer.put(depth);
+         buffer.put(",\"width\":");
+         buffer.put(width);
+         buffer.put(",\"root\":");
+
+         /* nodes nested from the root */
+         if(root)
+            export_json(buffer, root);
+         else
+            buffer.put("null");
+
+         buffer.put("}\n");
+         break;
+   }
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       export_tree
+
+Purpose:    Write this tree to a file in the given format, replacing the file if
+            it exists.
+
+Parameters: filename: name of the file to write
+            format:   format to write in
+
+Return:     written: whether the file could be opened and written
+------------------------------------------------------------------------------*/
+bool Tree<Data, Threshold> :: export_tree(const char * filename,
+                                          ExportFormat format)
+{
+   std :: ofstream fio(filename, std :: ios :: binary); /* output file */
+
+   /* file could not be opened */
+   if(!fio.is_open())
+      return false;
+
+   export_tree(fio, format);
+   fio.close();
+
+   return !fio.fail();
+}
+
+template<typename Data, unsigned int Threshold> /* define template below */
+/*------------------------------------------------------------------------------
+Name:       print_tree
+
+Purpose:    Print all nodes of the tree in ascending order of entry along with
+            datafields of each node and the tree itself.
+
+Parameters: none
+
+Return:     void
+------------------------------------------------------------------------------*/
+void Tree<Data, Threshold> :: print_tree()
+{
+   /* delegate to the buffered export, flush once at the end */
+   export_tree(std :: cout, EXPORT_NODES);
+   std :: cout.flush();
+}
+
+/* define all types for the template class, at the default threshold and at
+   two relaxed ones */
+template class Tree<char, 1>; /* trees of chars */
+template class Tree<char, 2>;
+template class Tree<char, 3>;
+template class Tree<short, 1>; /* trees of shorts */
+template class Tree<short, 2>;
+template class Tree<short, 3>;
+template class Tree<int, 1>; /* trees of ints */
+template class Tree<int, 2>;
+template class Tree<int, 3>;
+template class Tree<float, 1>; /* trees of floats */
+template class Tree<float, 2>;
+template class Tree<float, 3>;
+template class Tree<double, 1>; /* trees of doubles */
+template class Tree<double, 2>;
+template class Tree<double, 3>;
+template class Tree<long, 1>; /* trees of longs */
+template class Tree<long, 2>;
+template class Tree<long, 3>;
+template class Tree<std :: string, 1>; /* trees of strings */
+template class Tree<std :: string, 2>;
+template class Tree<std :: string, 3>;
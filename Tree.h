@@ -13,17 +13,35 @@ Purpose: This is the definition of the tree class. It is made up of nodes. Along
 #ifndef TREE_H
 #define TREE_H
 #include "Node.h"
+#include "Export.h"
+#include "Bloom.h"
+#include "LookupCache.h"
 
-template<typename Data> /* define template definiation for class below */
+static const unsigned int BALANCE_THRESHOLD = 1; /* default balance factor
+                                                    allowed, a strict avl
+                                                    tree */
+
+/* define template definiation for class below */
+template<typename Data, unsigned int Threshold = BALANCE_THRESHOLD>
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Name:        Tree
 
 Purpose:     Data structure made up of nodes to be formed in a binary structure
+             kept balanced so no node's balance goes past Threshold either way.
+             Thresholds above 1 give a relaxed avl tree, paths can be deeper
+             but inserts and removes rotate less often. The functions are
+             defined in Tree.cpp for thresholds 1, 2 and 3 only, others do not
+             compile.
 
 Data Fields: occupancy: amount of nodes in tree
              height:    how tall the tree is
              depth:     amount of levels in the tree
              width:     width of overall tree
+             entries:   amount of entries counting every occurrence
+             multiset:  whether duplicate entries are counted
+             rotations: single rotations done so far
+             filter:    optional bloom filter of the entries
+             cache:     optional cache of nodes found recently
              root:      top node in the tree
 
 Functions: Tree:         constructor
@@ -31,33 +49,88 @@ Functions: Tree:         constructor
            insert:       add nodes
            remove:       take out nodes
            find:         look for a node
+           range:        entries between two entries
+           count:        occurrences of an entry
+           size:         amount of entries counting every occurrence
+           search:       return node holding an entry
            delete_nodes: delete tree node by node
            rotate:       balance nodes
+           rotate_left:  move right child up
+           rotate_right: move left child up
+           update:       recompute fields of a node from its children
+           retrace:      update and balance nodes up from a change
+           tree_height:  how tall the tree is
+           rotation_count: rotations done so far
+           average_level: average steps of a sucessful find
+           enable_filter: keep a bloom filter to skip absent finds
+           disable_filter: stop keeping a bloom filter
+           filter_false_positive_rate: measured rate of absent finds not
+                                       skipped
+           enable_cache: keep a lookup cache of nodes found
+           disable_cache: stop keeping a lookup cache
+           cache_hits:   finds answered by the cache
+           cache_misses: finds left to the search
            first_node:   return node carrying smallest value
+           export_tree:  write the tree to a stream or file in a given format
            print_tree:   print tree attributes and all the nodes it is composed
                          of
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 class Tree
 {
+   static_assert(Threshold >= 1, "a balance threshold below 1 never holds");
+   static_assert(Threshold <= 3, "Tree.cpp defines thresholds 1 to 3 only");
+
    private:
       /* data fields */
       unsigned int occupancy, /* nodes in tree */
                    height,    /* how tall the tree is */
                    depth,     /* amount of levels */
-                   width;     /* tree's left and right height plus the root */
+                   width,     /* tree's left and right height plus the root */
+                   entries;   /* entries counting every occurrence */
+      bool multiset;          /* duplicates are counted instead of rejected */
+      unsigned long rotations; /* single rotations done so far */
+      BloomFilter * filter;   /* bloom filter of the entries, null if off */
+      LookupCache<Data> * cache; /* nodes found recently, null if off */
 
       Node<Data> * root;      /* first node in the tree */
 
+      /* functions */
+      Node<Data> * search(Data); /* node holding an entry, null if absent */
+      void rotate_left(Node<Data> *); /* move right child up */
+      void rotate_right(Node<Data> *); /* move left child up */
+      void update(Node<Data> *); /* recompute height, depth and balance */
+      void retrace(Node<Data> *); /* update and balance up to the root */
+
    public:
       /* functions */
-      Tree(void); /* constructor for defining a tree */
+      explicit Tree(bool = false); /* constructor for defining a tree or
+                                      multiset */
       ~Tree(void); /* destructor that deletes the tree by nodes */
       bool insert(Data); /* add nodes */
       bool remove(Data); /* take out nodes */
       bool find(Data); /* look for nodes */
+      unsigned int range(Data, Data); /* entries from low to high */
+      unsigned int count(Data); /* occurrences of an entry */
+      unsigned int size(void); /* entries counting every occurrence */
+      unsigned int tree_height(void); /* how tall the tree is */
+      unsigned long rotation_count(void); /* rotations done so far */
+      double average_level(void); /* average steps of a sucessful find */
+      void enable_filter(unsigned int); /* keep a bloom filter sized for an 
+                                           amount of entries */
+      void disable_filter(void); /* stop keeping a bloom filter */
+      double filter_false_positive_rate(void); /* absent finds not skipped */
+      void enable_cache(unsigned int); /* keep a lookup cache of some slots */
+      void disable_cache(void); /* stop keeping a lookup cache */
+      unsigned long long cache_hits(void); /* finds answered by the cache */
+      unsigned long long cache_misses(void); /* finds left to the search */
       void delete_nodes(Node<Data> *); /* delete all the nodes in the tree */
       void rotate(Node<Data> *); /* balance nodes */
-      Node<Data> * first_node(Tree<Data> *); /* return node of smallest entry */
+      Node<Data> * first_node(Tree<Data, Threshold> *); /* return node of 
+                                                          smallest entry */
+      void export_tree(std :: ostream &, ExportFormat); /* buffered dump of
+                                                           the tree */
+      bool export_tree(const char *, ExportFormat); /* dump the tree to a file
+                                                      */
       void print_tree(void); /* print tree attributes and all its nodes */
 };
 